@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <cmath>
+
+#include "color.h"
+
+/* Adaptive sampling
+
+   Keeps running mean and variance (Welford's algorithm) of the luminance of
+   all samples of a pixel next to the image accumulation buffer. A pixel stops
+   receiving samples once the standard error of its mean drops below the
+   tolerance (but not before minSamples), pixels that keep changing (set
+   boundary, bands) are sampled up to maxSamples. */
+
+inline float luminance(const color &c) { return 0.2126f*c.r + 0.7152f*c.g + 0.0722f*c.b; }
+
+struct adaptiveSettings
+{
+	int minSamples = 32; // samples every pixel gets before its variance is trusted
+	int maxSamples = 4096; // cap for pixels that do not converge
+	float tolerance = 0.002f; // allowed standard error of the pixel mean (about half an 8 bit step)
+};
+
+class varianceBuffer
+{
+private:
+	std::vector<float> mean;
+	std::vector<float> m2; // sum of squared differences from the mean
+	std::vector<int> samples;
+	adaptiveSettings settings;
+public:
+	varianceBuffer(const int nPixels, const adaptiveSettings &settings_)
+		: mean(nPixels, 0.f), m2(nPixels, 0.f), samples(nPixels, 0), settings(settings_) {}
+
+	void add(const int pixelIndex, const float value)
+	{
+		const int n = ++samples[pixelIndex];
+		const float delta = value - mean[pixelIndex];
+		mean[pixelIndex] += delta / n;
+		m2[pixelIndex] += delta * (value - mean[pixelIndex]);
+	}
+	int sampleCount(const int pixelIndex) const { return samples[pixelIndex]; }
+	const std::vector<int> &sampleCounts() const { return samples; }
+	float variance(const int pixelIndex) const
+	{
+		const int n = samples[pixelIndex];
+		return (n > 1) ? m2[pixelIndex] / (n - 1) : 0.f;
+	}
+	bool converged(const int pixelIndex) const
+	{
+		const int n = samples[pixelIndex];
+		if (n >= settings.maxSamples)
+			return true;
+		if (n < settings.minSamples)
+			return false;
+		// squared standard error of the mean against squared tolerance
+		return variance(pixelIndex) < settings.tolerance * settings.tolerance * n;
+	}
+};
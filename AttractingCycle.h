@@ -0,0 +1,104 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+#include "Complex.h"
+
+/* Attracting cycle of z -> z^2 + c
+
+   If a Julia seed has an attracting cycle, the critical orbit (starting at 0)
+   converges to it. The cycle is located once per render, its period and
+   multiplier are refined with Newton's method, and a disk around one cycle
+   point is grown such that f^period maps it strictly into itself. Every orbit
+   that enters this disk converges to the cycle, so it can stop as interior. */
+
+struct attractingCycle
+{
+	bool found = false;
+	int period = 0;
+	complex point = complex(0); // the cycle point orbits are tested against
+	complex multiplier = complex(0); // (f^period)'(point), |multiplier| < 1
+	double radius = 0; // orbits entering |z - point| < radius are attracted
+};
+
+// f^n(z) and its derivative for f(z) = z^2 + c
+inline complex iterateCycle(complex z, const complex &c, const int n, complex *derivative = nullptr)
+{
+	complex dz(1);
+	for (int ii = 0; ii < n; ii++)
+	{
+		dz = 2 * z * dz;
+		z = z * z + c;
+	}
+	if (derivative != nullptr)
+		*derivative = dz;
+	return z;
+}
+
+inline attractingCycle findAttractingCycle(const complex &c, const int maxPeriod = 64, const int settleIter = 100000)
+{
+	attractingCycle cycle;
+	// follow the critical orbit until it has settled on the cycle (or escaped)
+	complex z(0);
+	for (int ii = 0; ii < settleIter; ii++)
+	{
+		z = z * z + c;
+		if (z.cabs_squared() > 4.)
+			return cycle;
+	}
+	// smallest period that brings the orbit back
+	int period = 0;
+	complex w = z;
+	for (int ii = 1; ii <= maxPeriod; ii++)
+	{
+		w = w * w + c;
+		if ((w - z).cabs_squared() < 1e-16)
+		{
+			period = ii;
+			break;
+		}
+	}
+	if (period == 0)
+		return cycle;
+	// Newton on f^p(z) - z = 0 to get the cycle point to full precision
+	for (int ii = 0; ii < 8; ii++)
+	{
+		complex derivative;
+		const complex g = iterateCycle(z, c, period, &derivative) - z;
+		const complex dg = derivative - 1;
+		if (dg.cabs_squared() == 0)
+			break;
+		z = z - g / dg;
+	}
+	complex multiplier;
+	iterateCycle(z, c, period, &multiplier);
+	const double lambda = multiplier.cabs();
+	if (!(lambda < 1.))
+		return cycle;
+	// largest disk (halving from 0.5) that f^p maps into a smaller concentric disk;
+	// f^p(w) - z is analytic, so checking the boundary circle is enough
+	const double contraction = 0.5 * (1. + lambda);
+	const int nCircle = 64;
+	double radius = 0.5;
+	for (; radius > 1e-12; radius *= 0.5)
+	{
+		bool contracts = true;
+		for (int ii = 0; ii < nCircle && contracts; ii++)
+		{
+			const double phi = 2. * 3.14159265358979323846 * ii / nCircle;
+			const complex w0 = z + radius * complex(std::cos(phi), std::sin(phi));
+			contracts = (iterateCycle(w0, c, period) - z).cabs() < contraction * radius;
+		}
+		if (contracts)
+			break;
+	}
+	if (radius <= 1e-12)
+		return cycle;
+	// stay clear of the boundary between the sampled circle points
+	cycle.found = true;
+	cycle.period = period;
+	cycle.point = z;
+	cycle.multiplier = multiplier;
+	cycle.radius = 0.5 * radius;
+	return cycle;
+}
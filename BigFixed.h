@@ -0,0 +1,235 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Complex.h"
+
+/* Arbitrary precision fixed point numbers
+
+   Sign and magnitude, the magnitude is a little endian array of 32 bit limbs:
+   fracLimbs fractional limbs followed by one integer limb, so values must stay
+   below 2^32 in magnitude (plenty for orbits that are stopped at the bailout).
+   Only what a reference orbit needs is there: +, -, *, conversion from double
+   and from decimal strings (so deep zoom centers keep all their digits) and
+   rounding to double, double-double or quad-double (MultiPrecision.h). */
+
+class bigFixed
+{
+private:
+	bool negative = false;
+	std::vector<uint32_t> limbs;
+
+	int fracLimbs() const { return (int)limbs.size() - 1; }
+
+	// pads the lower precision operand with zero limbs at the bottom
+	static void align(bigFixed &a, bigFixed &b)
+	{
+		while (a.limbs.size() < b.limbs.size())
+			a.limbs.insert(a.limbs.begin(), 0);
+		while (b.limbs.size() < a.limbs.size())
+			b.limbs.insert(b.limbs.begin(), 0);
+	}
+	static int compareMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+	{
+		for (int ii = (int)a.size() - 1; ii >= 0; ii--)
+		{
+			if (a[ii] != b[ii])
+				return (a[ii] < b[ii]) ? -1 : 1;
+		}
+		return 0;
+	}
+	static std::vector<uint32_t> addMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+	{
+		std::vector<uint32_t> sum(a.size());
+		uint64_t carry = 0;
+		for (size_t ii = 0; ii < a.size(); ii++)
+		{
+			const uint64_t t = (uint64_t)a[ii] + b[ii] + carry;
+			sum[ii] = (uint32_t)t;
+			carry = t >> 32;
+		}
+		return sum;
+	}
+	// |a| - |b| for |a| >= |b|
+	static std::vector<uint32_t> subMagnitude(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+	{
+		std::vector<uint32_t> difference(a.size());
+		int64_t borrow = 0;
+		for (size_t ii = 0; ii < a.size(); ii++)
+		{
+			int64_t t = (int64_t)a[ii] - b[ii] - borrow;
+			borrow = (t < 0) ? 1 : 0;
+			difference[ii] = (uint32_t)(t + (borrow << 32));
+		}
+		return difference;
+	}
+	bool isZero() const
+	{
+		for (const uint32_t limb : limbs)
+		{
+			if (limb != 0)
+				return false;
+		}
+		return true;
+	}
+
+public:
+	bigFixed(const double value = 0, const int fracLimbs = 2) : limbs(fracLimbs + 1, 0)
+	{
+		negative = value < 0;
+		double magnitude = std::abs(value);
+		const double integerPart = std::floor(magnitude);
+		limbs[fracLimbs] = (uint32_t)integerPart;
+		magnitude -= integerPart;
+		// every step moves 32 bits of the mantissa into a limb, exact for doubles
+		for (int ii = fracLimbs - 1; ii >= 0 && magnitude > 0; ii--)
+		{
+			magnitude *= 4294967296.;
+			const double limb = std::floor(magnitude);
+			limbs[ii] = (uint32_t)limb;
+			magnitude -= limb;
+		}
+	}
+	// decimal string like "-0.743643887037158704752191506114774"
+	bigFixed(const std::string &value, const int fracLimbs) : limbs(fracLimbs + 1, 0)
+	{
+		size_t pos = 0;
+		if (pos < value.size() && (value[pos] == '-' || value[pos] == '+'))
+			negative = value[pos++] == '-';
+		uint64_t integerPart = 0;
+		for (; pos < value.size() && value[pos] != '.'; pos++)
+			integerPart = 10 * integerPart + (value[pos] - '0');
+		limbs[fracLimbs] = (uint32_t)integerPart;
+		// fraction digits as a decimal number, multiplying it by 2^32 pushes
+		// the next limb out of the top
+		std::vector<uint32_t> digits;
+		for (pos++; pos < value.size(); pos++)
+			digits.push_back(value[pos] - '0');
+		for (int ii = fracLimbs - 1; ii >= 0; ii--)
+		{
+			uint64_t carry = 0;
+			for (int kk = (int)digits.size() - 1; kk >= 0; kk--)
+			{
+				const uint64_t t = (uint64_t)digits[kk] * 4294967296ull + carry;
+				digits[kk] = (uint32_t)(t % 10);
+				carry = t / 10;
+			}
+			limbs[ii] = (uint32_t)carry;
+		}
+		if (isZero())
+			negative = false;
+	}
+
+	int precisionBits() const { return 32 * fracLimbs(); }
+
+	double toDouble() const
+	{
+		// three limbs from the first non zero one hold more than the 53 bits of a double
+		int top = fracLimbs();
+		while (top > 0 && limbs[top] == 0)
+			top--;
+		double value = 0;
+		for (int ii = top; ii >= 0 && ii >= top - 2; ii--)
+			value += std::ldexp((double)limbs[ii], 32 * (ii - fracLimbs()));
+		return (negative) ? -value : value;
+	}
+
+	// rounded to a sum of doubles (double, doubleDouble, quadDouble), every
+	// component takes the leading bits of what the ones before left over
+	template <class T>
+	T toScalar() const
+	{
+		T value(0);
+		bigFixed rest = *this;
+		for (int ii = 0; ii < scalarComponents<T>(); ii++)
+		{
+			const double component = rest.toDouble();
+			value = value + T(component);
+			rest = rest - bigFixed(component, fracLimbs());
+		}
+		return value;
+	}
+
+	bigFixed operator-() const
+	{
+		bigFixed result = *this;
+		result.negative = !negative && !isZero();
+		return result;
+	}
+	bigFixed operator+(const bigFixed &rhs) const
+	{
+		bigFixed a = *this;
+		bigFixed b = rhs;
+		align(a, b);
+		bigFixed result = a;
+		if (a.negative == b.negative)
+			result.limbs = addMagnitude(a.limbs, b.limbs);
+		else if (compareMagnitude(a.limbs, b.limbs) >= 0)
+			result.limbs = subMagnitude(a.limbs, b.limbs);
+		else
+		{
+			result.limbs = subMagnitude(b.limbs, a.limbs);
+			result.negative = b.negative;
+		}
+		if (result.isZero())
+			result.negative = false;
+		return result;
+	}
+	bigFixed operator-(const bigFixed &rhs) const { return *this + (-rhs); }
+	bigFixed operator*(const bigFixed &rhs) const
+	{
+		bigFixed a = *this;
+		bigFixed b = rhs;
+		align(a, b);
+		// schoolbook product, the result keeps the limbs from the fracLimbs-th on
+		const size_t n = a.limbs.size();
+		std::vector<uint32_t> product(2 * n, 0);
+		for (size_t ii = 0; ii < n; ii++)
+		{
+			uint64_t carry = 0;
+			for (size_t jj = 0; jj < n; jj++)
+			{
+				const uint64_t t = (uint64_t)a.limbs[ii] * b.limbs[jj] + product[ii + jj] + carry;
+				product[ii + jj] = (uint32_t)t;
+				carry = t >> 32;
+			}
+			product[ii + n] = (uint32_t)carry;
+		}
+		bigFixed result = a;
+		result.limbs.assign(product.begin() + (n - 1), product.begin() + (2 * n - 1));
+		result.negative = (a.negative != b.negative) && !result.isZero();
+		return result;
+	}
+};
+
+// fractional limbs needed to resolve pixels at magnification magn with
+// 64 bits to spare for the orbit
+inline int fracLimbsForMagnification(const double magn)
+{
+	const double bits = std::log2(std::max(magn, 1.)) + 64;
+	return (int)std::ceil(bits / 32);
+}
+
+struct bigComplex
+{
+	bigFixed x, y;
+
+	bigComplex() {}
+	bigComplex(const bigFixed &x_, const bigFixed &y_) : x(x_), y(y_) {}
+	bigComplex(const complex &z, const int fracLimbs) : x(z.x, fracLimbs), y(z.y, fracLimbs) {}
+
+	bigComplex operator+(const bigComplex &rhs) const { return bigComplex(x + rhs.x, y + rhs.y); }
+	bigComplex sqr() const
+	{
+		const bigFixed xy = x * y;
+		return bigComplex(x * x - y * y, xy + xy);
+	}
+	complex toComplex() const { return complex(x.toDouble(), y.toDouble()); }
+	template <class T>
+	complexT<T> toComplexT() const { return complexT<T>(x.toScalar<T>(), y.toScalar<T>()); }
+};
+
+inline complex toComplex(const bigComplex &z) { return z.toComplex(); }
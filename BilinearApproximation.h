@@ -0,0 +1,105 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "Complex.h"
+
+/* Bilinear approximation (BLA) of perturbed orbits
+
+   While the offset dz of a sample is small against the reference orbit Z, the
+   dz^2 term of a perturbed step can be dropped and the step becomes linear:
+
+       dz -> A dz + B dc      with A = 2 Z[m], B = 1 (Mandelbrot) or 0 (Julia)
+
+   Linear steps compose, so l steps starting at orbit index m collapse into a
+   single (A, B) pair, valid while |dz| stays below a radius R. The table keeps
+   level k merges of 2^k steps at indexes aligned to 2^k, a sample at index m
+   takes the longest one that is aligned with m and whose radius it is inside.
+   Radii follow Zhuoran's merge rule, with the largest |dc| of the view
+   bounding the parameter term. */
+
+struct blaStep
+{
+	complex A;
+	complex B;
+	double radius2; // |dz|^2 must stay below this
+	int length; // iterations covered
+};
+
+class blaTable
+{
+private:
+	std::vector<std::vector<blaStep>> levels; // levels[k][j] covers 2^k steps from firstIndex + j*2^k
+	int firstIndex = 0;
+
+	static blaStep merge(const blaStep &x, const blaStep &y, const double maxDelta)
+	{
+		// x first, then y
+		const double ax = x.A.cabs();
+		const double rx = std::sqrt(x.radius2);
+		const double ry = std::sqrt(y.radius2);
+		double radius = rx;
+		if (ax > 0)
+			radius = std::max(0., std::min(rx, (ry - x.B.cabs() * maxDelta) / ax));
+		return {y.A * x.A, y.A * x.B + y.B, radius * radius, x.length + y.length};
+	}
+
+public:
+	blaTable() {}
+	// orbit is the reference, maxDelta the largest |dc| of any sample; the
+	// default epsilon keeps the dropped term below the rounding of the step
+	blaTable(const std::vector<complex> &orbit, const int firstIndex_, const bool withParameter, const double maxDelta,
+		const double epsilon = 0x1p-53) : firstIndex(firstIndex_)
+	{
+		const int nSteps = (int)orbit.size() - 1 - firstIndex;
+		if (nSteps < 2)
+			return;
+		levels.emplace_back(nSteps);
+		for (int jj = 0; jj < nSteps; jj++)
+		{
+			// dropping dz^2 against 2 Z dz costs less than epsilon relative error,
+			// so the radius scales with the orbit magnitude |Z|
+			const complex A = 2 * orbit[firstIndex + jj];
+			const double radius = epsilon * A.cabs();
+			levels[0][jj] = {A, complex(withParameter ? 1. : 0.), radius * radius, 1};
+		}
+		while (levels.back().size() > 1)
+		{
+			const std::vector<blaStep> &lower = levels.back();
+			std::vector<blaStep> upper(lower.size() / 2);
+			for (size_t jj = 0; jj < upper.size(); jj++)
+				upper[jj] = merge(lower[2*jj], lower[2*jj + 1], maxDelta);
+			levels.push_back(std::move(upper));
+		}
+	}
+
+	// longest step from orbit index m that a sample at |dz|^2 = dz2 may take,
+	// nullptr if there is none (single steps are left to the perturbation loop)
+	const blaStep *lookup(const int m, const double dz2, const int maxLength) const
+	{
+		const int j = m - firstIndex;
+		if (j < 0 || levels.size() < 2)
+			return nullptr;
+		// j aligned to 2^k for all k up to the number of trailing zero bits
+		int level = (j == 0) ? (int)levels.size() - 1 : std::min((int)levels.size() - 1, __builtin_ctz(j));
+		for (; level >= 1; level--)
+		{
+			const int index = j >> level;
+			if (index >= (int)levels[level].size())
+				continue;
+			const blaStep &step = levels[level][index];
+			if (dz2 < step.radius2 && step.length <= maxLength)
+				return &step;
+		}
+		return nullptr;
+	}
+};
+
+// profiling counters, shared by all threads of a render
+struct blaCounters
+{
+	std::atomic<long long> iterations{0}; // all iterations of all samples, skipped ones included
+	std::atomic<long long> skipped{0}; // iterations covered by BLA steps
+};
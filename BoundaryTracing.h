@@ -0,0 +1,168 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <omp.h>
+
+#include "IterationKernel.h"
+
+/* Mariani-Silver subdivision
+
+   The Mandelbrot set and connected Julia sets have no holes: if no pixel on
+   the border of a rectangle escapes, nothing inside it does either (up to
+   filaments thinner than a pixel that slip between the border samples). The
+   first pass iterates the pixel centers on the border of a block, fills the
+   block without iterating its inside when none of them escaped, and
+   otherwise splits it in two along the longer side (the halves share the
+   cut line) until blocks are small enough to iterate completely. The
+   unknown pixels of a border go through the kernel as one batch.
+   The result is a one sample per pixel preview, and tells the AA passes
+   which pixels lie deep enough in the interior to skip. Disconnected Julia
+   sets (seeds outside the Mandelbrot set) break the assumption. */
+
+class interiorMap
+{
+public:
+	// complex coordinate (or deep zoom offset) of a pixel coordinate
+	using coordinateMap = std::function<complex(const double x, const double y)>;
+private:
+	enum : uint8_t { unknown, iterated, filled };
+	int width = 0, height = 0;
+	std::vector<orbitResult> results;
+	std::vector<uint8_t> state;
+	std::atomic<long long> iteratedPixels{0};
+
+	struct block { int x0, y0, x1, y1; }; // inclusive corners
+
+	// iterates the unknown pixels among indexes
+	void iterate(abstractBaseFractal &fractal, const orbitKernel kernel, const coordinateMap &coordinate,
+		const std::vector<int> &indexes, std::vector<complex> &z0, std::vector<int> &batch, std::vector<orbitResult> &batchResults)
+	{
+		batch.clear();
+		z0.clear();
+		for (const int index : indexes)
+		{
+			if (state[index] != unknown)
+				continue;
+			state[index] = iterated; // borders list their corners twice
+			batch.push_back(index);
+			z0.push_back(coordinate(index % width, index / width));
+		}
+		batchResults.resize(batch.size());
+		kernel(fractal, z0.data(), batchResults.data(), (int)batch.size());
+		for (size_t ii = 0; ii < batch.size(); ii++)
+			results[batch[ii]] = batchResults[ii];
+		iteratedPixels += batch.size();
+	}
+
+	void subdivide(abstractBaseFractal &fractal, const orbitKernel kernel, const coordinateMap &coordinate,
+		const block &b, const int maxIter, const int minSize)
+	{
+		std::vector<int> indexes;
+		std::vector<complex> z0;
+		std::vector<int> batch;
+		std::vector<orbitResult> batchResults;
+		std::vector<block> stack{b};
+		while (!stack.empty())
+		{
+			const block r = stack.back();
+			stack.pop_back();
+			indexes.clear();
+			for (int x = r.x0; x <= r.x1; x++)
+			{
+				indexes.push_back(r.y0*width + x);
+				indexes.push_back(r.y1*width + x);
+			}
+			for (int y = r.y0 + 1; y < r.y1; y++)
+			{
+				indexes.push_back(y*width + r.x0);
+				indexes.push_back(y*width + r.x1);
+			}
+			iterate(fractal, kernel, coordinate, indexes, z0, batch, batchResults);
+			const bool uniform = std::none_of(indexes.begin(), indexes.end(),
+				[&](const int index) { return results[index].bailedOut; });
+			if (uniform)
+			{
+				for (int y = r.y0 + 1; y < r.y1; y++)
+				{
+					for (int x = r.x0 + 1; x < r.x1; x++)
+					{
+						const int index = y*width + x;
+						if (state[index] != unknown)
+							continue;
+						state[index] = filled;
+						results[index] = {complex(0), maxIter, false, true};
+					}
+				}
+				continue;
+			}
+			const int w = r.x1 - r.x0;
+			const int h = r.y1 - r.y0;
+			if (std::max(w, h) <= minSize)
+			{
+				indexes.clear();
+				for (int y = r.y0 + 1; y < r.y1; y++)
+					for (int x = r.x0 + 1; x < r.x1; x++)
+						indexes.push_back(y*width + x);
+				iterate(fractal, kernel, coordinate, indexes, z0, batch, batchResults);
+				continue;
+			}
+			if (w >= h)
+			{
+				const int xm = r.x0 + w / 2;
+				stack.push_back({r.x0, r.y0, xm, r.y1});
+				stack.push_back({xm, r.y0, r.x1, r.y1});
+			}
+			else
+			{
+				const int ym = r.y0 + h / 2;
+				stack.push_back({r.x0, r.y0, r.x1, ym});
+				stack.push_back({r.x0, ym, r.x1, r.y1});
+			}
+		}
+	}
+
+public:
+	interiorMap() {}
+	interiorMap(const int width_, const int height_)
+		: width(width_), height(height_), results(width_*height_), state(width_*height_, unknown) {}
+
+	// first pass over all pixel centers, blocks of blockSize pixels are traced
+	// in parallel (each on its own, they do not share borders)
+	void trace(abstractBaseFractal &fractal, const orbitKernel kernel, const coordinateMap &coordinate,
+		const int maxIter, const int blockSize = 64, const int minSize = 6)
+	{
+		std::vector<block> blocks;
+		for (int y0 = 0; y0 < height; y0 += blockSize)
+			for (int x0 = 0; x0 < width; x0 += blockSize)
+				blocks.push_back({x0, y0, std::min(x0 + blockSize, width) - 1, std::min(y0 + blockSize, height) - 1});
+		#pragma omp parallel for schedule(dynamic)
+		for (int ii = 0; ii < (int)blocks.size(); ii++)
+			subdivide(fractal, kernel, coordinate, blocks[ii], maxIter, minSize);
+	}
+
+	const orbitResult &at(const int x, const int y) const { return results[y*width + x]; }
+	bool interior(const int x, const int y) const { return !results[y*width + x].bailedOut; }
+	// jittered samples of pixel (x, y) land anywhere between the centers of its
+	// neighbours, it is only skipped if it was filled (enclosed by an interior
+	// border) and everything within two pixels is interior, one pixel of margin
+	// still lets the exterior through at pinches between bulbs
+	bool skip(const int x, const int y) const
+	{
+		if (state[y*width + x] != filled)
+			return false;
+		for (int yy = std::max(0, y - 2); yy <= std::min(height - 1, y + 2); yy++)
+		{
+			for (int xx = std::max(0, x - 2); xx <= std::min(width - 1, x + 2); xx++)
+			{
+				if (!interior(xx, yy))
+					return false;
+			}
+		}
+		return true;
+	}
+	long long iteratedCount() const { return iteratedPixels; }
+	long long filledCount() const { return std::count(state.begin(), state.end(), filled); }
+};
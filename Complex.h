@@ -1,151 +1,195 @@
 #pragma once
 #include <stdio.h>
+#include <cmath>
 #include <iostream>
-#include <bitset>
+#include <cstdint>
+#include <type_traits>
+
+#include "MultiPrecision.h"
 
 using std::cout;
 
-// make a double version only for now
-class complex {
+// complex numbers over a scalar type T: double, or doubleDouble / quadDouble
+// (MultiPrecision.h) for zooms beyond what a double resolves
+template <class T>
+class complexT {
 public:
-	double x, y;
+	using scalar = T;
+	T x, y;
 	// constructors
-	complex() {}
-	constexpr complex(double x_) : x(x_), y(0) {}
-	constexpr complex(double x_, double y_) : x(x_), y(y_) {}
+	complexT() {}
+	constexpr complexT(T x_) : x(x_), y(0) {}
+	constexpr complexT(T x_, T y_) : x(x_), y(y_) {}
+	// widening from a double complex, e.g. a pixel offset
+	template <class S, class = typename std::enable_if<!std::is_same<S, T>::value>::type>
+	explicit constexpr complexT(const complexT<S> &z) : x(z.x), y(z.y) {}
 	// basic methods
-	constexpr double cabs_squared() const { return x*x + y*y; }
-	constexpr double cabs() const { return std::sqrt(this->cabs_squared()); }
-	constexpr complex abs() const { return complex(std::abs(x), std::abs(y)); }
-	constexpr complex flip() const { return complex(y, x); }
-	constexpr complex conj() const { return complex(x, -y); }
-	constexpr double angle() const { return std::atan2(y, x); }
-	constexpr complex sqr() const { return complex(x*x - y*y, 2*x*y); }
-	constexpr complex cube() const { return complex(x, y) * complex(x, y).sqr(); }
-	// complex logarithm (principal value)
-	constexpr complex log() const {
-		return complex(std::log(this->cabs()), this->angle());
+	constexpr T cabs_squared() const { return x*x + y*y; }
+	constexpr T cabs() const { using std::sqrt; return sqrt(this->cabs_squared()); }
+	constexpr complexT abs() const { using std::abs; return complexT(abs(x), abs(y)); }
+	constexpr complexT flip() const { return complexT(y, x); }
+	constexpr complexT conj() const { return complexT(x, -y); }
+	constexpr T angle() const { return std::atan2(y, x); }
+	constexpr complexT sqr() const { return complexT(x*x - y*y, 2*x*y); }
+	constexpr complexT cube() const { return complexT(x, y) * complexT(x, y).sqr(); }
+	// complex logarithm (principal value), log |z| = log(|z|^2) / 2 saves the sqrt
+	constexpr complexT log() const {
+		return complexT(0.5 * std::log(this->cabs_squared()), this->angle());
 	}
 	// complex exponential function (principal value)
-	constexpr complex exp() const {
-		return complex(std::cos(y), std::sin(y)) * std::exp(x); 
+	constexpr complexT exp() const {
+		return complexT(std::cos(y), std::sin(y)) * std::exp(x);
 	}
 
 	// OPERATORS
-	complex& operator= (const complex& rhs) {
+	complexT& operator= (const complexT& rhs) {
 		x = rhs.x;
 		y = rhs.y;
 		return *this;
 	}
-	complex& operator+= (const complex& rhs) {
+	complexT& operator+= (const complexT& rhs) {
 		x = x + rhs.x;
 		y = y + rhs.y;
 		return *this;
 	}
-	complex& operator-= (const complex& rhs) {
+	complexT& operator-= (const complexT& rhs) {
 		x = x - rhs.x;
 		y = y - rhs.y;
 		return *this;
 	}
-	complex& operator *= (const complex& rhs) {
-		x = x * rhs.x + y * rhs.y;
-		y = y * rhs.x - x * rhs.y;
-		return  *this;
+	complexT& operator *= (const complexT& rhs) {
+		return *this = *this * rhs;
 	}
-	constexpr complex operator+ (const double rhs) const   { return complex(x + rhs, y);                                   }
-	constexpr complex operator+ (const complex& rhs) const { return complex(x + rhs.x, y + rhs.y);                         }
-	constexpr complex operator- (const double rhs) const   { return complex(x - rhs, y);                                   }
-	constexpr complex operator- (const complex& rhs) const { return complex(x - rhs.x, y - rhs.y);                         }
-	constexpr complex operator* (const double rhs) const   { return complex(x * rhs, y * rhs);                             }
-	constexpr complex operator* (const complex& rhs) const { return complex(x * rhs.x - y * rhs.y, x * rhs.y + y * rhs.x); }
-	constexpr complex operator/ (const double rhs) const   { return complex(x / rhs, y / rhs);                             }
-	constexpr complex operator/ (const complex& rhs) const {
-		double den = rhs.cabs_squared();
-		return complex(x * rhs.x + y * rhs.y, y * rhs.x - x * rhs.y) / den;
+	constexpr complexT operator+ (const T rhs) const        { return complexT(x + rhs, y);                                   }
+	constexpr complexT operator+ (const complexT& rhs) const { return complexT(x + rhs.x, y + rhs.y);                         }
+	constexpr complexT operator- (const T rhs) const        { return complexT(x - rhs, y);                                   }
+	constexpr complexT operator- (const complexT& rhs) const { return complexT(x - rhs.x, y - rhs.y);                         }
+	constexpr complexT operator* (const T rhs) const        { return complexT(x * rhs, y * rhs);                             }
+	constexpr complexT operator* (const complexT& rhs) const { return complexT(x * rhs.x - y * rhs.y, x * rhs.y + y * rhs.x); }
+	constexpr complexT operator/ (const T rhs) const        { return complexT(x / rhs, y / rhs);                             }
+	constexpr complexT operator/ (const complexT& rhs) const {
+		T den = rhs.cabs_squared();
+		return complexT(x * rhs.x + y * rhs.y, y * rhs.x - x * rhs.y) / den;
 	}
 
 
 };
 
+using complex = complexT<double>;
+
+// rounds the components to double
+template <class T>
+inline complex toComplex(const complexT<T> &z) { return complex(toDouble(z.x), toDouble(z.y)); }
 
 // overload << operator
-std::ostream& operator<<(std::ostream& os, const complex& z) {
+template <class T>
+std::ostream& operator<<(std::ostream& os, const complexT<T>& z) {
 	const char sign = (z.y < 0) ? '\0' : '+';
 	os << z.x << sign << z.y << "i";
 	return os;
 }
 
+// the real operand of the mixed operators converts to the scalar type of the complex one
+template <class T> using realOperand = typename complexT<T>::scalar;
+
 // real + complex
 template <typename T>
-constexpr complex operator+ (const T lhs, const complex& rhs)
+constexpr complexT<T> operator+ (const realOperand<T> lhs, const complexT<T>& rhs)
 {
-	return complex(rhs.x + lhs, rhs.y);
+	return complexT<T>(rhs.x + lhs, rhs.y);
 }
 
 // real - complex
 template <typename T>
-constexpr complex operator- (const T lhs, const complex& rhs)
+constexpr complexT<T> operator- (const realOperand<T> lhs, const complexT<T>& rhs)
 {
-	return complex(lhs - rhs.x, -rhs.y);
+	return complexT<T>(lhs - rhs.x, -rhs.y);
 }
 
 // real * complex
 template <typename T>
-constexpr complex operator* (const T lhs, const complex& rhs)
+constexpr complexT<T> operator* (const realOperand<T> lhs, const complexT<T>& rhs)
 {
-	return complex(rhs.x * lhs, rhs.y * lhs);
+	return complexT<T>(rhs.x * lhs, rhs.y * lhs);
 }
 
 // real / complex - use complex division
 template <typename T>
-constexpr complex operator/ (const T lhs, const complex& rhs)
+constexpr complexT<T> operator/ (const realOperand<T> lhs, const complexT<T>& rhs)
 {
-	return complex(lhs) / rhs;
+	return complexT<T>(lhs) / rhs;
 }
 
 //exponentiation
+// complex number raised to a power N known at compile time, unrolled into the
+// shortest chain of squarings and multiplications (optimal up to N = 16,
+// binary square and multiply beyond)
+template <int N, class T>
+constexpr complexT<T> pow(const complexT<T>& z)
+{
+	static_assert(N >= 0, "pow<N> takes non-negative powers, use pow(z, n) for negative ones");
+	if constexpr (N == 0)
+		return complexT<T>(1);
+	else if constexpr (N == 1)
+		return z;
+	else if constexpr (N == 15)
+		return pow<3>(pow<5>(z)); // 2, 4, 5, 10, 15 instead of 2, 3, 6, 7, 14, 15
+	else if constexpr (N % 2 == 0)
+		return pow<N / 2>(z).sqr();
+	else
+		return pow<N - 1>(z) * z;
+}
+
+// largest power with its own pow<N> branch in pow(z, n), larger ones square and multiply
+constexpr int maxUnrolledPower = 16;
+
 // complex number raised to integer power
-constexpr complex pow(const complex& z_, const int n)
+template <class T>
+constexpr complexT<T> pow(const complexT<T>& z_, const int n)
 {
+	using complex = complexT<T>;
 	complex z = z_;
-	uint16_t nAbs = std::abs(n);
+	unsigned int nAbs = (n < 0) ? 0u - n : n;
 	switch (nAbs)
 	{
-		case 0:                              return complex(1);
-		case 1:                              return (n >= 0) ? z : 1/z;
-		case 2: z = z.sqr();                 return (n >= 0) ? z : 1/z;
-		case 3: z = z.sqr() * z;             return (n >= 0) ? z : 1/z;
-		case 4: z = (z.sqr()).sqr();         return (n >= 0) ? z : 1/z;
-		case 5: z = z.sqr().sqr() * z;       return (n >= 0) ? z : 1/z;
-		case 6: z = (z.sqr() * z).sqr();     return (n >= 0) ? z : 1/z;
-		case 7: z = (z.sqr() * z).sqr() * z; return (n >= 0) ? z : 1/z;
-		case 8: z = z.sqr().sqr().sqr();     return (n >= 0) ? z : 1/z;
+		case 0: return complex(1);
+		case 1: break;
+		case 2: z = pow<2>(z); break;
+		case 3: z = pow<3>(z); break;
+		case 4: z = pow<4>(z); break;
+		case 5: z = pow<5>(z); break;
+		case 6: z = pow<6>(z); break;
+		case 7: z = pow<7>(z); break;
+		case 8: z = pow<8>(z); break;
+		case 9: z = pow<9>(z); break;
+		case 10: z = pow<10>(z); break;
+		case 11: z = pow<11>(z); break;
+		case 12: z = pow<12>(z); break;
+		case 13: z = pow<13>(z); break;
+		case 14: z = pow<14>(z); break;
+		case 15: z = pow<15>(z); break;
+		case 16: z = pow<16>(z); break;
 		default:
 		{
-			cout << "\nEXECUTING DEFAULT CASE\n";
-			complex z2(1);
-			cout << "nAbs = " << nAbs << " (binary " << std::bitset<8*sizeof(nAbs)>(nAbs) << ")\n";
-			while (nAbs > 1)
+			// square and multiply, from the lowest bit up
+			complex power = z;
+			z = (nAbs & 1) ? z : complex(1);
+			for (nAbs >>= 1; nAbs > 0; nAbs >>= 1)
 			{
+				power = power.sqr();
 				if (nAbs & 1)
-				{
-				    z2 *= z;
-				    cout << "last bit was 1, multiplying zRet *= z2, it is now " << z2 << "\n";
-				}
-				z = z.sqr();
-				cout << "squaring z2, it is now " << z2 << ", incrementing shifting nAbs by 1 bit.\n";
-				nAbs >>= 1;
-				cout << "nAbs = " << nAbs << " (binary " << std::bitset<8*sizeof(nAbs)>(nAbs) << ")\n";
+					z = z * power;
 			}
-			z *= z2;
-			return (n >= 0) ? z : 1/z;	
+			break;
 		}
 	}
+	return (n >= 0) ? z : 1/z;
 }
 
 //complex number raised to non-integer real power
-constexpr complex pow(const complex&z, const double x) {
-	double r = z.cabs_squared();
-	double phi = z.angle();
-	return complex(std::cos(x*phi), std::sin(x*phi)) * std::pow(r, x*0.5);
-}
\ No newline at end of file
+template <class T>
+constexpr complexT<T> pow(const complexT<T>&z, const double x) {
+	T r = z.cabs_squared();
+	T phi = z.angle();
+	return complexT<T>(std::cos(x*phi), std::sin(x*phi)) * std::pow(r, x*0.5);
+}
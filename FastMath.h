@@ -0,0 +1,300 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+/* Fast transcendental functions for formulas
+
+   exp, log, sin / cos (jointly), atan2 and sinh / cosh (jointly) without
+   calls into libm: range reduction to a small interval, then a truncated
+   Taylor series long enough that its first dropped term is below 1e-16.
+   Results are within a few ulp of libm over the ranges orbits visit,
+   which is plenty for escape time fractals (orbits are chaotic, the
+   rounding of a single operation already changes them). What is given up:
+   - exp overflows to inf above 709.78 and flushes to 0 below -708 (no
+     subnormal results)
+   - sin / cos lose accuracy past |x| ~ 1e6 (three part Cody-Waite
+     reduction) and are meaningless past 2^51
+   - atan2 does not handle infinite arguments
+   The functions have no branches, only selects and integer bit tricks on
+   64 bit lanes, so loops over them vectorize (AVX2 lacks conversions
+   between 64 bit integers and double, those are done with the 2^52 + 2^51
+   rounding trick instead). The batch versions below are such loops,
+   compiled for AVX2 and AVX-512 and picked at runtime like the SIMD
+   kernels; they give bitwise the same results as the scalar functions.
+   Batches are what they are for: one value at a time, with the next call
+   waiting for the result (an orbit), libm's table driven functions have
+   shorter dependency chains and are faster. */
+
+namespace fastMathDetail
+{
+	// adding 2^52 + 2^51 rounds |x| < 2^51 to an integer that ends up in the low mantissa bits
+	constexpr double roundingMagic = 6755399441055744.0;
+	constexpr double ln2High = 0.6931471806019545; // 32 bits, k * ln2High is exact
+	constexpr double ln2Low = -4.2009150726810846e-11;
+	constexpr double log2e = 1.4426950408889634;
+	constexpr double halfPi1 = 1.5707963267341256; // pi/2 in three parts, 33 + 33 + 53 bits
+	constexpr double halfPi2 = 6.077100506303966e-11;
+	constexpr double halfPi3 = 2.0222662487959506e-21;
+	constexpr double twoOverPi = 0.6366197723675814;
+	constexpr double pi = 3.141592653589793;
+
+	inline int64_t bits(const double x)
+	{
+		int64_t b;
+		std::memcpy(&b, &x, sizeof(b));
+		return b;
+	}
+	inline double fromBits(const int64_t b)
+	{
+		double x;
+		std::memcpy(&x, &b, sizeof(x));
+		return x;
+	}
+	// x rounded to the nearest integer, which is also left in the low bits of magic
+	inline double roundWithMagic(const double x, double &magic)
+	{
+		magic = x + roundingMagic;
+		return magic - roundingMagic;
+	}
+	// integer that roundWithMagic left in magic
+	inline int64_t magicInteger(const double magic) { return bits(magic) - bits(roundingMagic); }
+	// condition ? a : b with bit masks; ?: between a result and special values
+	// becomes a branch around the code computing the result, which does not
+	// vectorize without AVX-512 masking (floating point ops may trap)
+	inline double select(const bool condition, const double a, const double b)
+	{
+		const int64_t mask = -(int64_t)condition;
+		return fromBits((bits(a) & mask) | (bits(b) & ~mask));
+	}
+	// small integer to double without a conversion instruction
+	inline double integerToDouble(const int64_t k) { return fromBits(bits(roundingMagic) + k) - roundingMagic; }
+}
+
+// e^x
+inline double fastExp(const double x)
+{
+	using namespace fastMathDetail;
+	// out of range x give garbage below and are replaced at the end
+	// x = k ln2 + r with |r| <= ln2 / 2
+	double magic;
+	const double k = roundWithMagic(x * log2e, magic);
+	const double r = (x - k * ln2High) - k * ln2Low;
+	double p = 1. / 6227020800.; // 1/13!
+	p = p * r + 1. / 479001600.;
+	p = p * r + 1. / 39916800.;
+	p = p * r + 1. / 3628800.;
+	p = p * r + 1. / 362880.;
+	p = p * r + 1. / 40320.;
+	p = p * r + 1. / 5040.;
+	p = p * r + 1. / 720.;
+	p = p * r + 1. / 120.;
+	p = p * r + 1. / 24.;
+	p = p * r + 1. / 6.;
+	p = p * r + 0.5;
+	p = p * r + 1.;
+	p = p * r + 1.;
+	// 2^(k - 1) * 2, 2^k alone overflows for k = 1024 just below the cutoff
+	const double scale = fromBits((magicInteger(magic) + 1022) << 52);
+	const double result = p * scale * 2.;
+	return select(x > 709.78, std::numeric_limits<double>::infinity(), select(x < -708., 0., result));
+}
+
+// natural logarithm, -inf for 0 and NaN for negative x
+inline double fastLog(const double x)
+{
+	using namespace fastMathDetail;
+	const bool subnormal = x < std::numeric_limits<double>::min();
+	const double scaled = select(subnormal, x * 18014398509481984., x); // 2^54
+	// x = m 2^e with sqrt(1/2) <= m < sqrt(2)
+	const int64_t b = bits(scaled);
+	double m = fromBits((b & 0x000FFFFFFFFFFFFFll) | 0x3FF0000000000000ll);
+	double e = integerToDouble((int64_t)((uint64_t)b >> 52) - 1023) - select(subnormal, 54., 0.);
+	const bool high = m > 1.4142135623730951;
+	m = select(high, 0.5 * m, m);
+	e = select(high, e + 1., e);
+	// log m = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.172
+	const double s = (m - 1.) / (m + 1.);
+	const double s2 = s * s;
+	double p = 1. / 19.;
+	p = p * s2 + 1. / 17.;
+	p = p * s2 + 1. / 15.;
+	p = p * s2 + 1. / 13.;
+	p = p * s2 + 1. / 11.;
+	p = p * s2 + 1. / 9.;
+	p = p * s2 + 1. / 7.;
+	p = p * s2 + 1. / 5.;
+	p = p * s2 + 1. / 3.;
+	const double logM = 2. * s + 2. * s * s2 * p;
+	const double result = e * ln2High + (logM + e * ln2Low);
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	const double infinity = std::numeric_limits<double>::infinity();
+	return select(x == 0., -infinity, select(x == infinity, infinity, select(x > 0., result, nan)));
+}
+
+// sin and cos of x at the price of one
+inline void fastSinCos(const double x, double &sine, double &cosine)
+{
+	using namespace fastMathDetail;
+	// x = k pi/2 + r with |r| <= pi/4
+	double magic;
+	const double k = roundWithMagic(x * twoOverPi, magic);
+	const double r = ((x - k * halfPi1) - k * halfPi2) - k * halfPi3;
+	const double r2 = r * r;
+	double s = -1. / 1307674368000.; // -1/15!
+	s = s * r2 + 1. / 6227020800.;
+	s = s * r2 - 1. / 39916800.;
+	s = s * r2 + 1. / 362880.;
+	s = s * r2 - 1. / 5040.;
+	s = s * r2 + 1. / 120.;
+	s = s * r2 - 1. / 6.;
+	s = r + r * r2 * s;
+	double c = 1. / 20922789888000.; // 1/16!
+	c = c * r2 - 1. / 87178291200.;
+	c = c * r2 + 1. / 479001600.;
+	c = c * r2 - 1. / 3628800.;
+	c = c * r2 + 1. / 40320.;
+	c = c * r2 - 1. / 720.;
+	c = c * r2 + 1. / 24.;
+	c = c * r2 - 0.5;
+	c = 1. + r2 * c;
+	// quadrant k mod 4 rotates (cos r, sin r) by k pi/2
+	const int64_t quadrant = magicInteger(magic) & 3;
+	sine = (quadrant == 0) ? s : (quadrant == 1) ? c : (quadrant == 2) ? -s : -c;
+	cosine = (quadrant == 0) ? c : (quadrant == 1) ? -s : (quadrant == 2) ? -c : s;
+}
+
+// angle of (x, y) in [-pi, pi], with the signs of zeros like std::atan2
+inline double fastAtan2(const double y, const double x)
+{
+	using namespace fastMathDetail;
+	const double ax = fromBits(bits(x) & 0x7FFFFFFFFFFFFFFFll);
+	const double ay = fromBits(bits(y) & 0x7FFFFFFFFFFFFFFFll);
+	const bool swap = ay > ax;
+	const double lo = (swap) ? ax : ay;
+	const double hi = (swap) ? ay : ax;
+	// atan(lo / hi) = offset + atan(t) with t = (lo - c hi) / (hi + c lo) and
+	// c = tan(offset) for offsets 0, pi/8, pi/4, which leaves |t| <= tan(pi/16)
+	const bool third = lo > 0.6681786379192989 * hi; // tan(3 pi/16)
+	const bool second = lo > 0.198912367379658 * hi; // tan(pi/16)
+	const double c = select(third, 1., select(second, 0.41421356237309503, 0.));
+	const double offset = select(third, 0.7853981633974483, select(second, 0.39269908169872414, 0.));
+	const double t = select(hi == 0., 0., (lo - c * hi) / (hi + c * lo));
+	const double t2 = t * t;
+	double p = -1. / 19.;
+	p = p * t2 + 1. / 17.;
+	p = p * t2 - 1. / 15.;
+	p = p * t2 + 1. / 13.;
+	p = p * t2 - 1. / 11.;
+	p = p * t2 + 1. / 9.;
+	p = p * t2 - 1. / 7.;
+	p = p * t2 + 1. / 5.;
+	p = p * t2 - 1. / 3.;
+	double angle = offset + (t + t * t2 * p);
+	angle = select(swap, 0.5 * pi - angle, angle);
+	angle = select(bits(x) < 0, pi - angle, angle); // also for x = -0
+	return select(bits(y) < 0, -angle, angle);
+}
+
+// sinh and cosh of x from one exp
+inline void fastSinhCosh(const double x, double &sinh, double &cosh)
+{
+	using namespace fastMathDetail;
+	const double e = fastExp(fromBits(bits(x) & 0x7FFFFFFFFFFFFFFFll));
+	const double inverse = 1. / e;
+	cosh = 0.5 * (e + inverse);
+	// e - 1/e cancels for small x, the series does not
+	const double x2 = x * x;
+	double s = 1. / 39916800.; // 1/11!
+	s = s * x2 + 1. / 362880.;
+	s = s * x2 + 1. / 5040.;
+	s = s * x2 + 1. / 120.;
+	s = s * x2 + 1. / 6.;
+	const double series = x + x * x2 * s;
+	const double large = 0.5 * (e - inverse);
+	sinh = select(x2 < 0.0625, series, select(x < 0., -large, large));
+}
+
+// runtime instruction set selection, shared with the SIMD kernels (SimdKernel.h)
+enum class simdLevel { scalar, avx2, avx512 };
+
+inline simdLevel detectSimdLevel()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (__builtin_cpu_supports("avx512f"))
+		return simdLevel::avx512;
+	if (__builtin_cpu_supports("avx2"))
+		return simdLevel::avx2;
+#endif
+	return simdLevel::scalar;
+}
+
+/* batch versions: the same functions over arrays, for kernels that keep
+   the state of many orbits in memory (see runFormulaLanes in FormulaCompiler.h) */
+
+// loop of f(0) ... f(n - 1) for every instruction set, f calls the scalar functions above
+template <class Function>
+inline void fastMathLoop(const int n, const Function &f)
+{
+	#pragma omp simd
+	for (int ii = 0; ii < n; ii++)
+		f(ii);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+template <class Function>
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+inline void fastMathLoopAvx2(const int n, const Function &f)
+{
+	#pragma omp simd
+	for (int ii = 0; ii < n; ii++)
+		f(ii);
+}
+
+template <class Function>
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+inline void fastMathLoopAvx512(const int n, const Function &f)
+{
+	#pragma omp simd
+	for (int ii = 0; ii < n; ii++)
+		f(ii);
+}
+#endif
+
+template <class Function>
+inline void fastMathBatch(const int n, const Function &f)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	static const simdLevel level = detectSimdLevel();
+	if (level == simdLevel::avx512)
+		return fastMathLoopAvx512(n, f);
+	if (level == simdLevel::avx2)
+		return fastMathLoopAvx2(n, f);
+#endif
+	fastMathLoop(n, f);
+}
+
+inline void fastExp(const double *x, double *result, const int n)
+{
+	fastMathBatch(n, [=](const int ii) { result[ii] = fastExp(x[ii]); });
+}
+
+inline void fastLog(const double *x, double *result, const int n)
+{
+	fastMathBatch(n, [=](const int ii) { result[ii] = fastLog(x[ii]); });
+}
+
+inline void fastSinCos(const double *x, double *sine, double *cosine, const int n)
+{
+	fastMathBatch(n, [=](const int ii) { fastSinCos(x[ii], sine[ii], cosine[ii]); });
+}
+
+inline void fastAtan2(const double *y, const double *x, double *result, const int n)
+{
+	fastMathBatch(n, [=](const int ii) { result[ii] = fastAtan2(y[ii], x[ii]); });
+}
+
+inline void fastSinhCosh(const double *x, double *sinh, double *cosh, const int n)
+{
+	fastMathBatch(n, [=](const int ii) { fastSinhCosh(x[ii], sinh[ii], cosh[ii]); });
+}
@@ -0,0 +1,1066 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FastMath.h"
+#include "FractalFormulas.h"
+
+/* Formula compiler
+
+   Formulas written in a small language in the style of Ultra Fractal's
+   sections, compiled when they are loaded instead of with the program:
+
+       ; Burning Ship
+       param:
+         maxIter = 250
+       init:
+         z = pixel
+       loop:
+         z = sqr(abs(z)) + pixel
+       bailout:
+         |z| < 128
+
+   All values are complex. init runs once per orbit, then loop and bailout
+   alternate until bailout is false (its real part is 0) or maxIter is
+   reached; z is what the orbit reports. pixel is the sample coordinate,
+   |x| is the squared modulus (as in UF) and ';' starts a comment. There are
+   + - * / ^, comparisons (of real parts), && ||, complex literals (x, y) and
+   the functions sqr abs conj flip exp log sin cos real imag cabs. param
+   declares named constants (maxIter is the iteration cap).
+
+   The source is parsed into an expression tree that folds constants and
+   fuses the common patterns (x*x -> sqr, sqr(x) + y and x*y + w into one
+   operation, |x| < y into one test) and is then flattened into bytecode
+   over a file of complex registers: variables, constants, then temporaries.
+   The interpreter is one switch per instruction, the Mandelbrot loop is a
+   single sqrAdd plus a normLess. The render kernel runs a batch of orbits
+   side by side, each instruction for all of them at once, which amortizes
+   the dispatch and lets exp, log, sin, cos and pow use the vectorized
+   functions of FastMath.h (3-4x faster than libm one orbit at a time).
+   toCpp() writes the same program as a C++
+   formula class for builds that want it compiled ahead of time. */
+
+enum class formulaOp : uint8_t
+{
+	move, add, sub, mul, div, neg, sqr, sqrAdd, mulAdd, powInt, pow,
+	abs, conj, flip, exp, log, sin, cos, real, imag, cabs, norm, makeComplex,
+	less, greater, lessEqual, greaterEqual, logicalAnd, logicalOr, normLess
+};
+
+struct formulaInstruction
+{
+	formulaOp op;
+	uint8_t dst, a, b, c;
+	int n; // exponent of powInt
+};
+
+constexpr int formulaRegisters = 64;
+
+inline complex complexSin(const complex &z)
+{
+	return complex(std::sin(z.x) * std::cosh(z.y), std::cos(z.x) * std::sinh(z.y));
+}
+
+inline complex complexCos(const complex &z)
+{
+	return complex(std::cos(z.x) * std::cosh(z.y), -std::sin(z.x) * std::sinh(z.y));
+}
+
+inline complex truth(const bool x) { return complex(x ? 1. : 0.); }
+
+inline void runFormula(const formulaInstruction *code, const int n, complex *r)
+{
+	for (const formulaInstruction *in = code, *end = code + n; in != end; in++)
+	{
+		switch (in->op)
+		{
+			case formulaOp::move: r[in->dst] = r[in->a]; break;
+			case formulaOp::add: r[in->dst] = r[in->a] + r[in->b]; break;
+			case formulaOp::sub: r[in->dst] = r[in->a] - r[in->b]; break;
+			case formulaOp::mul: r[in->dst] = r[in->a] * r[in->b]; break;
+			case formulaOp::div: r[in->dst] = r[in->a] / r[in->b]; break;
+			case formulaOp::neg: r[in->dst] = complex(-r[in->a].x, -r[in->a].y); break;
+			case formulaOp::sqr: r[in->dst] = r[in->a].sqr(); break;
+			case formulaOp::sqrAdd: r[in->dst] = r[in->a].sqr() + r[in->b]; break;
+			case formulaOp::mulAdd: r[in->dst] = r[in->a] * r[in->b] + r[in->c]; break;
+			case formulaOp::powInt: r[in->dst] = pow(r[in->a], in->n); break;
+			case formulaOp::pow: r[in->dst] = (r[in->b] * r[in->a].log()).exp(); break;
+			case formulaOp::abs: r[in->dst] = r[in->a].abs(); break;
+			case formulaOp::conj: r[in->dst] = r[in->a].conj(); break;
+			case formulaOp::flip: r[in->dst] = r[in->a].flip(); break;
+			case formulaOp::exp: r[in->dst] = r[in->a].exp(); break;
+			case formulaOp::log: r[in->dst] = r[in->a].log(); break;
+			case formulaOp::sin: r[in->dst] = complexSin(r[in->a]); break;
+			case formulaOp::cos: r[in->dst] = complexCos(r[in->a]); break;
+			case formulaOp::real: r[in->dst] = complex(r[in->a].x); break;
+			case formulaOp::imag: r[in->dst] = complex(r[in->a].y); break;
+			case formulaOp::cabs: r[in->dst] = complex(r[in->a].cabs()); break;
+			case formulaOp::norm: r[in->dst] = complex(r[in->a].cabs_squared()); break;
+			case formulaOp::makeComplex: r[in->dst] = complex(r[in->a].x, r[in->b].x); break;
+			case formulaOp::less: r[in->dst] = truth(r[in->a].x < r[in->b].x); break;
+			case formulaOp::greater: r[in->dst] = truth(r[in->a].x > r[in->b].x); break;
+			case formulaOp::lessEqual: r[in->dst] = truth(r[in->a].x <= r[in->b].x); break;
+			case formulaOp::greaterEqual: r[in->dst] = truth(r[in->a].x >= r[in->b].x); break;
+			case formulaOp::logicalAnd: r[in->dst] = truth(r[in->a].x != 0 && r[in->b].x != 0); break;
+			case formulaOp::logicalOr: r[in->dst] = truth(r[in->a].x != 0 || r[in->b].x != 0); break;
+			case formulaOp::normLess: r[in->dst] = truth(r[in->a].cabs_squared() < r[in->b].x); break;
+		}
+	}
+}
+
+// register files of up to width orbits side by side (structure of arrays),
+// register k of lane l is (x[k*width + l], y[k*width + l])
+struct formulaLanes
+{
+	static constexpr int width = 64;
+	std::vector<double> x, y;
+	std::vector<double> scratch; // four rows of width for the transcendental ops
+	explicit formulaLanes(const int registers) : x(registers*width), y(registers*width), scratch(4*width) {}
+	int registers() const { return (int)this->x.size() / width; }
+	complex get(const int k, const int lane) const { return complex(this->x[k*width + lane], this->y[k*width + lane]); }
+	void set(const int k, const int lane, const complex &value)
+	{
+		this->x[k*width + lane] = value.x;
+		this->y[k*width + lane] = value.y;
+	}
+	void copyLane(const int from, const int to)
+	{
+		for (int k = 0; k < this->registers(); k++)
+			this->set(k, to, this->get(k, from));
+	}
+};
+
+// runFormula over lanes 0 ... lanes - 1, one instruction at a time for all of
+// them: the arithmetic vectorizes and exp, log, sin, cos and pow go through
+// the batch functions of FastMath.h
+inline void runFormulaLanes(const formulaInstruction *code, const int n, formulaLanes &r, const int lanes)
+{
+	constexpr int width = formulaLanes::width;
+	double *t0 = r.scratch.data(), *t1 = t0 + width, *t2 = t1 + width, *t3 = t2 + width;
+	for (const formulaInstruction *in = code, *end = code + n; in != end; in++)
+	{
+		double *dx = &r.x[in->dst*width], *dy = &r.y[in->dst*width];
+		const double *ax = &r.x[in->a*width], *ay = &r.y[in->a*width];
+		const double *bx = &r.x[in->b*width], *by = &r.y[in->b*width];
+		const double *cx = &r.x[in->c*width], *cy = &r.y[in->c*width];
+		// results are computed completely before dst is written, dst may be an operand
+		switch (in->op)
+		{
+			case formulaOp::move:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l]; dy[l] = ay[l]; });
+				break;
+			case formulaOp::add:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l] + bx[l]; dy[l] = ay[l] + by[l]; });
+				break;
+			case formulaOp::sub:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l] - bx[l]; dy[l] = ay[l] - by[l]; });
+				break;
+			case formulaOp::mul:
+				fastMathLoop(lanes, [=](const int l) {
+					const double x = ax[l] * bx[l] - ay[l] * by[l];
+					const double y = ax[l] * by[l] + ay[l] * bx[l];
+					dx[l] = x;
+					dy[l] = y;
+				});
+				break;
+			case formulaOp::div:
+				fastMathLoop(lanes, [=](const int l) {
+					const double den = bx[l] * bx[l] + by[l] * by[l];
+					const double x = (ax[l] * bx[l] + ay[l] * by[l]) / den;
+					const double y = (ay[l] * bx[l] - ax[l] * by[l]) / den;
+					dx[l] = x;
+					dy[l] = y;
+				});
+				break;
+			case formulaOp::neg:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = -ax[l]; dy[l] = -ay[l]; });
+				break;
+			case formulaOp::sqr:
+				fastMathLoop(lanes, [=](const int l) {
+					const double x = ax[l] * ax[l] - ay[l] * ay[l];
+					const double y = 2 * ax[l] * ay[l];
+					dx[l] = x;
+					dy[l] = y;
+				});
+				break;
+			case formulaOp::sqrAdd:
+				fastMathLoop(lanes, [=](const int l) {
+					const double x = ax[l] * ax[l] - ay[l] * ay[l] + bx[l];
+					const double y = 2 * ax[l] * ay[l] + by[l];
+					dx[l] = x;
+					dy[l] = y;
+				});
+				break;
+			case formulaOp::mulAdd:
+				fastMathLoop(lanes, [=](const int l) {
+					const double x = ax[l] * bx[l] - ay[l] * by[l] + cx[l];
+					const double y = ax[l] * by[l] + ay[l] * bx[l] + cy[l];
+					dx[l] = x;
+					dy[l] = y;
+				});
+				break;
+			case formulaOp::powInt:
+				for (int l = 0; l < lanes; l++)
+				{
+					const complex z = pow(complex(ax[l], ay[l]), in->n);
+					dx[l] = z.x;
+					dy[l] = z.y;
+				}
+				break;
+			case formulaOp::pow: // exp(b log a)
+				fastMathLoop(lanes, [=](const int l) { t0[l] = ax[l] * ax[l] + ay[l] * ay[l]; });
+				fastLog(t0, t1, lanes);
+				fastAtan2(ay, ax, t2, lanes);
+				fastMathLoop(lanes, [=](const int l) {
+					const double logAbs = 0.5 * t1[l];
+					t0[l] = bx[l] * logAbs - by[l] * t2[l];
+					t3[l] = bx[l] * t2[l] + by[l] * logAbs;
+				});
+				fastExp(t0, t1, lanes);
+				fastSinCos(t3, t2, t0, lanes);
+				fastMathLoop(lanes, [=](const int l) { dx[l] = t1[l] * t0[l]; dy[l] = t1[l] * t2[l]; });
+				break;
+			case formulaOp::abs:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = std::abs(ax[l]); dy[l] = std::abs(ay[l]); });
+				break;
+			case formulaOp::conj:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l]; dy[l] = -ay[l]; });
+				break;
+			case formulaOp::flip:
+				fastMathLoop(lanes, [=](const int l) {
+					const double x = ay[l];
+					dy[l] = ax[l];
+					dx[l] = x;
+				});
+				break;
+			case formulaOp::exp:
+				fastExp(ax, t0, lanes);
+				fastSinCos(ay, t1, t2, lanes);
+				fastMathLoop(lanes, [=](const int l) { dx[l] = t0[l] * t2[l]; dy[l] = t0[l] * t1[l]; });
+				break;
+			case formulaOp::log:
+				fastMathLoop(lanes, [=](const int l) { t0[l] = ax[l] * ax[l] + ay[l] * ay[l]; });
+				fastLog(t0, t1, lanes);
+				fastAtan2(ay, ax, t2, lanes);
+				fastMathLoop(lanes, [=](const int l) { dx[l] = 0.5 * t1[l]; dy[l] = t2[l]; });
+				break;
+			case formulaOp::sin:
+				fastSinCos(ax, t0, t1, lanes);
+				fastSinhCosh(ay, t2, t3, lanes);
+				fastMathLoop(lanes, [=](const int l) { dx[l] = t0[l] * t3[l]; dy[l] = t1[l] * t2[l]; });
+				break;
+			case formulaOp::cos:
+				fastSinCos(ax, t0, t1, lanes);
+				fastSinhCosh(ay, t2, t3, lanes);
+				fastMathLoop(lanes, [=](const int l) { dx[l] = t1[l] * t3[l]; dy[l] = -t0[l] * t2[l]; });
+				break;
+			case formulaOp::real:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l]; dy[l] = 0; });
+				break;
+			case formulaOp::imag:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ay[l]; dy[l] = 0; });
+				break;
+			case formulaOp::cabs:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = std::sqrt(ax[l] * ax[l] + ay[l] * ay[l]); dy[l] = 0; });
+				break;
+			case formulaOp::norm:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = ax[l] * ax[l] + ay[l] * ay[l]; dy[l] = 0; });
+				break;
+			case formulaOp::makeComplex:
+				fastMathLoop(lanes, [=](const int l) { dy[l] = bx[l]; dx[l] = ax[l]; });
+				break;
+			case formulaOp::less:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] < bx[l]) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::greater:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] > bx[l]) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::lessEqual:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] <= bx[l]) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::greaterEqual:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] >= bx[l]) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::logicalAnd:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] != 0 && bx[l] != 0) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::logicalOr:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] != 0 || bx[l] != 0) ? 1. : 0.; dy[l] = 0; });
+				break;
+			case formulaOp::normLess:
+				fastMathLoop(lanes, [=](const int l) { dx[l] = (ax[l] * ax[l] + ay[l] * ay[l] < bx[l]) ? 1. : 0.; dy[l] = 0; });
+				break;
+		}
+	}
+}
+
+// compiled sections of a formula and the register file they start from
+struct formulaProgram
+{
+	std::vector<formulaInstruction> init, loop, bailout;
+	std::vector<complex> initialRegisters; // variables (0) and constants
+	std::vector<std::string> variables; // names of the first registers
+	std::map<std::string, complex> parameters;
+	int maxIter = 250;
+	int pixel = 0, z = 0; // registers of pixel and z
+	int bailoutResult = 0; // register holding the bailout condition
+};
+
+class formulaCompiler
+{
+private:
+	// expression tree, children are indexes into nodes
+	struct node
+	{
+		enum kind_t { constant, variable, operation } kind;
+		formulaOp op = formulaOp::move;
+		complex value = complex(0);
+		int var = -1;
+		int args[3] = {-1, -1, -1};
+		int n = 0;
+	};
+	struct token
+	{
+		enum kind_t { number, name, symbol, newline, end } kind;
+		std::string text;
+		double value = 0;
+		int line = 0;
+	};
+
+	std::vector<token> tokens;
+	size_t pos = 0;
+	std::vector<node> nodes;
+	std::string error;
+	formulaProgram program;
+	std::map<std::string, int> variableIndex;
+	std::map<std::string, complex> constants; // param values by name
+
+	bool fail(const std::string &message)
+	{
+		if (error.empty())
+		{
+			std::ostringstream text;
+			text << "line " << tokens[std::min(pos, tokens.size() - 1)].line << ": " << message;
+			error = text.str();
+		}
+		return false;
+	}
+
+	bool tokenize(const std::string &source)
+	{
+		int line = 1;
+		for (size_t ii = 0; ii < source.size();)
+		{
+			const char ch = source[ii];
+			if (ch == ';')
+			{
+				while (ii < source.size() && source[ii] != '\n')
+					ii++;
+			}
+			else if (ch == '\n')
+			{
+				tokens.push_back({token::newline, "\n", 0, line++});
+				ii++;
+			}
+			else if (std::isspace((unsigned char)ch))
+				ii++;
+			else if (std::isdigit((unsigned char)ch) || (ch == '.' && ii + 1 < source.size() && std::isdigit((unsigned char)source[ii + 1])))
+			{
+				char *stop = nullptr;
+				const double value = std::strtod(source.c_str() + ii, &stop);
+				const size_t length = stop - (source.c_str() + ii);
+				tokens.push_back({token::number, source.substr(ii, length), value, line});
+				ii += length;
+			}
+			else if (std::isalpha((unsigned char)ch) || ch == '_')
+			{
+				size_t length = 1;
+				while (ii + length < source.size() && (std::isalnum((unsigned char)source[ii + length]) || source[ii + length] == '_'))
+					length++;
+				tokens.push_back({token::name, source.substr(ii, length), 0, line});
+				ii += length;
+			}
+			else
+			{
+				const std::string two = source.substr(ii, 2);
+				if (two == "<=" || two == ">=" || two == "&&" || two == "||")
+				{
+					tokens.push_back({token::symbol, two, 0, line});
+					ii += 2;
+				}
+				else if (std::string("+-*/^|=<>(),:").find(ch) != std::string::npos)
+				{
+					tokens.push_back({token::symbol, std::string(1, ch), 0, line});
+					ii++;
+				}
+				else
+				{
+					tokens.push_back({token::end, "", 0, line});
+					pos = tokens.size() - 1;
+					return fail(std::string("unexpected character ") + ch);
+				}
+			}
+		}
+		tokens.push_back({token::end, "", 0, line});
+		return true;
+	}
+
+	const token &peek() const { return tokens[pos]; }
+	bool accept(const std::string &symbol)
+	{
+		if (peek().kind == token::symbol && peek().text == symbol)
+		{
+			pos++;
+			return true;
+		}
+		return false;
+	}
+	bool expect(const std::string &symbol) { return accept(symbol) || fail("expected " + symbol); }
+
+	int addNode(const node &n)
+	{
+		nodes.push_back(n);
+		return (int)nodes.size() - 1;
+	}
+	int constantNode(const complex &value)
+	{
+		node n;
+		n.kind = node::constant;
+		n.value = value;
+		return addNode(n);
+	}
+	bool isConstant(const int index) const { return index >= 0 && nodes[index].kind == node::constant; }
+	bool isOp(const int index, const formulaOp op) const { return nodes[index].kind == node::operation && nodes[index].op == op; }
+	bool sameValue(const int a, const int b) const
+	{
+		return a == b || (nodes[a].kind == node::variable && nodes[b].kind == node::variable && nodes[a].var == nodes[b].var);
+	}
+
+	// builds an operation node, folding constants and fusing patterns on the way
+	int operation(const formulaOp op, const int a, const int b = -1, const int c = -1, const int n = 0)
+	{
+		if (a < 0 || !error.empty())
+			return -1;
+		// x * x -> sqr(x)
+		if (op == formulaOp::mul && sameValue(a, b))
+			return operation(formulaOp::sqr, a);
+		// x^n -> powInt(x), pow(complex, int) takes at most 2 log2(n) multiplications
+		if (op == formulaOp::pow && isConstant(b) && nodes[b].value.y == 0 && nodes[b].value.x == std::round(nodes[b].value.x)
+			&& std::abs(nodes[b].value.x) <= 64)
+		{
+			const int exponent = (int)nodes[b].value.x;
+			if (exponent == 1)
+				return a;
+			if (exponent == 2)
+				return operation(formulaOp::sqr, a);
+			return operation(formulaOp::powInt, a, -1, -1, exponent);
+		}
+		// sqr(x) + y -> sqrAdd(x, y), x * y + w -> mulAdd(x, y, w)
+		if (op == formulaOp::add)
+		{
+			for (const int swap : {0, 1})
+			{
+				const int product = (swap) ? b : a;
+				const int other = (swap) ? a : b;
+				if (isOp(product, formulaOp::sqr))
+					return operation(formulaOp::sqrAdd, nodes[product].args[0], other);
+				if (isOp(product, formulaOp::mul))
+					return operation(formulaOp::mulAdd, nodes[product].args[0], nodes[product].args[1], other);
+			}
+		}
+		// |x| < y -> normLess(x, y)
+		if (op == formulaOp::less && isOp(a, formulaOp::norm))
+			return operation(formulaOp::normLess, nodes[a].args[0], b);
+		node result;
+		result.kind = node::operation;
+		result.op = op;
+		result.args[0] = a;
+		result.args[1] = b;
+		result.args[2] = c;
+		result.n = n;
+		const bool foldable = isConstant(a) && (b < 0 || isConstant(b)) && (c < 0 || isConstant(c));
+		if (!foldable)
+			return addNode(result);
+		// evaluate with the interpreter itself so folding can not disagree with it
+		complex r[4] = {nodes[a].value, (b >= 0) ? nodes[b].value : complex(0), (c >= 0) ? nodes[c].value : complex(0), complex(0)};
+		const formulaInstruction instruction = {op, 3, 0, 1, 2, n};
+		runFormula(&instruction, 1, r);
+		return constantNode(r[3]);
+	}
+
+	int variableNode(const std::string &name)
+	{
+		auto it = variableIndex.find(name);
+		if (it == variableIndex.end())
+		{
+			it = variableIndex.emplace(name, (int)program.variables.size()).first;
+			program.variables.push_back(name);
+		}
+		node n;
+		n.kind = node::variable;
+		n.var = it->second;
+		return addNode(n);
+	}
+
+	// expression grammar, lowest precedence first; all return -1 on errors
+	int parseExpression() { return parseOr(); }
+	int parseOr()
+	{
+		int a = parseAnd();
+		while (a >= 0 && accept("||"))
+			a = operation(formulaOp::logicalOr, a, parseAnd());
+		return a;
+	}
+	int parseAnd()
+	{
+		int a = parseComparison();
+		while (a >= 0 && accept("&&"))
+			a = operation(formulaOp::logicalAnd, a, parseComparison());
+		return a;
+	}
+	int parseComparison()
+	{
+		const int a = parseSum();
+		if (a < 0)
+			return -1;
+		if (accept("<="))
+			return operation(formulaOp::lessEqual, a, parseSum());
+		if (accept(">="))
+			return operation(formulaOp::greaterEqual, a, parseSum());
+		if (accept("<"))
+			return operation(formulaOp::less, a, parseSum());
+		if (accept(">"))
+			return operation(formulaOp::greater, a, parseSum());
+		return a;
+	}
+	int parseSum()
+	{
+		int a = parseProduct();
+		while (a >= 0)
+		{
+			if (accept("+"))
+				a = operation(formulaOp::add, a, parseProduct());
+			else if (accept("-"))
+				a = operation(formulaOp::sub, a, parseProduct());
+			else
+				break;
+		}
+		return a;
+	}
+	int parseProduct()
+	{
+		int a = parseUnary();
+		while (a >= 0)
+		{
+			if (accept("*"))
+				a = operation(formulaOp::mul, a, parseUnary());
+			else if (accept("/"))
+				a = operation(formulaOp::div, a, parseUnary());
+			else
+				break;
+		}
+		return a;
+	}
+	int parseUnary()
+	{
+		if (accept("-"))
+			return operation(formulaOp::neg, parseUnary());
+		if (accept("+"))
+			return parseUnary();
+		return parsePower();
+	}
+	int parsePower()
+	{
+		const int a = parsePrimary();
+		if (a >= 0 && accept("^"))
+			return operation(formulaOp::pow, a, parseUnary()); // right associative
+		return a;
+	}
+	int parsePrimary()
+	{
+		const token t = peek();
+		if (t.kind == token::number)
+		{
+			pos++;
+			return constantNode(complex(t.value));
+		}
+		if (accept("("))
+		{
+			const int a = parseExpression();
+			if (a >= 0 && accept(","))
+			{
+				const int b = parseExpression();
+				return (expect(")")) ? operation(formulaOp::makeComplex, a, b) : -1;
+			}
+			return (expect(")")) ? a : -1;
+		}
+		if (accept("|"))
+		{
+			const int a = parseExpression();
+			return (expect("|")) ? operation(formulaOp::norm, a) : -1;
+		}
+		if (t.kind == token::name)
+		{
+			pos++;
+			if (accept("("))
+			{
+				static const std::map<std::string, formulaOp> functions = {
+					{"sqr", formulaOp::sqr}, {"abs", formulaOp::abs}, {"conj", formulaOp::conj}, {"flip", formulaOp::flip},
+					{"exp", formulaOp::exp}, {"log", formulaOp::log}, {"sin", formulaOp::sin}, {"cos", formulaOp::cos},
+					{"real", formulaOp::real}, {"imag", formulaOp::imag}, {"cabs", formulaOp::cabs}};
+				const auto function = functions.find(t.text);
+				if (function == functions.end())
+				{
+					fail("unknown function " + t.text);
+					return -1;
+				}
+				const int a = parseExpression();
+				return (a >= 0 && expect(")")) ? operation(function->second, a) : -1;
+			}
+			const auto constant = constants.find(t.text);
+			if (constant != constants.end())
+				return constantNode(constant->second);
+			return variableNode(t.text);
+		}
+		fail("expected an expression");
+		return -1;
+	}
+
+	// code generation works on symbolic registers: variables are numbered
+	// from 0, constants from constantBase and temporaries from temporaryBase,
+	// link() maps them into one register file once all sections are known
+	static constexpr int constantBase = 1 << 16;
+	static constexpr int temporaryBase = 1 << 20;
+	struct pendingInstruction { formulaOp op; int dst, a, b, c, n; };
+	std::vector<complex> constantPool;
+	int temporaries = 0;
+	int maxTemporaries = 0;
+
+	// returns the register holding the node's value
+	int emit(const int index, std::vector<pendingInstruction> &code)
+	{
+		const node &n = nodes[index];
+		if (n.kind == node::variable)
+			return n.var;
+		if (n.kind == node::constant)
+		{
+			for (size_t ii = 0; ii < constantPool.size(); ii++)
+			{
+				if (constantPool[ii].x == n.value.x && constantPool[ii].y == n.value.y)
+					return constantBase + (int)ii;
+			}
+			constantPool.push_back(n.value);
+			return constantBase + (int)constantPool.size() - 1;
+		}
+		int args[3] = {0, 0, 0};
+		for (int ii = 0; ii < 3; ii++)
+		{
+			if (n.args[ii] >= 0)
+				args[ii] = emit(n.args[ii], code);
+		}
+		const int dst = temporaryBase + temporaries++;
+		maxTemporaries = std::max(maxTemporaries, temporaries);
+		code.push_back({n.op, dst, args[0], args[1], args[2], n.n});
+		return dst;
+	}
+
+	// statement lists of one section: name = expression per line
+	struct statement { int var; int expression; };
+
+	bool parseStatements(std::vector<statement> &statements)
+	{
+		while (peek().kind != token::end)
+		{
+			if (peek().kind == token::newline)
+			{
+				pos++;
+				continue;
+			}
+			// next section header
+			if (peek().kind == token::name && tokens[pos + 1].kind == token::symbol && tokens[pos + 1].text == ":")
+				return true;
+			if (peek().kind != token::name)
+				return fail("expected an assignment");
+			const std::string name = peek().text;
+			pos++;
+			if (!expect("="))
+				return false;
+			const int expression = parseExpression();
+			if (expression < 0)
+				return false;
+			if (constants.count(name))
+				return fail("can not assign to parameter " + name);
+			statements.push_back({nodes[variableNode(name)].var, expression});
+		}
+		return true;
+	}
+
+	bool parseParameters()
+	{
+		while (peek().kind != token::end)
+		{
+			if (peek().kind == token::newline)
+			{
+				pos++;
+				continue;
+			}
+			if (peek().kind == token::name && tokens[pos + 1].kind == token::symbol && tokens[pos + 1].text == ":")
+				break;
+			if (peek().kind != token::name)
+				return fail("expected a parameter");
+			const std::string name = peek().text;
+			pos++;
+			if (!expect("="))
+				return false;
+			const int value = parseExpression();
+			if (value < 0)
+				return false;
+			if (!isConstant(value))
+				return fail("parameter " + name + " is not a constant");
+			if (name == "maxIter")
+			{
+				const double maxIter = nodes[value].value.x;
+				if (maxIter < 1 || maxIter > maxIterLimit)
+					return fail("maxIter is out of range");
+				program.maxIter = (int)maxIter;
+			}
+			else
+			{
+				constants[name] = nodes[value].value;
+				program.parameters[name] = nodes[value].value;
+			}
+		}
+		return true;
+	}
+
+	// turns the statements of a section into code
+	void generate(const std::vector<statement> &statements, std::vector<pendingInstruction> &code)
+	{
+		for (const statement &s : statements)
+		{
+			const size_t before = code.size();
+			const int value = emit(s.expression, code);
+			if (code.size() > before && value == code.back().dst)
+				code.back().dst = s.var; // the last instruction writes the variable directly
+			else
+				code.push_back({formulaOp::move, s.var, value, 0, 0, 0});
+			temporaries = 0; // temporaries only live within a statement
+		}
+	}
+
+	// maps the symbolic registers to variables, constants, temporaries
+	void link(const std::vector<pendingInstruction> &pending, std::vector<formulaInstruction> &code) const
+	{
+		const int nVariables = (int)program.variables.size();
+		const int nConstants = (int)constantPool.size();
+		const auto resolve = [&](const int r)
+		{
+			if (r >= temporaryBase)
+				return (uint8_t)(nVariables + nConstants + r - temporaryBase);
+			if (r >= constantBase)
+				return (uint8_t)(nVariables + r - constantBase);
+			return (uint8_t)r;
+		};
+		for (const pendingInstruction &p : pending)
+			code.push_back({p.op, resolve(p.dst), resolve(p.a), resolve(p.b), resolve(p.c), p.n});
+	}
+
+public:
+	// false (and the reason in errorMessage) if source is not a valid formula
+	bool compile(const std::string &source, formulaProgram &result, std::string &errorMessage)
+	{
+		if (!tokenize(source))
+		{
+			errorMessage = error;
+			return false;
+		}
+		program.pixel = nodes[variableNode("pixel")].var;
+		program.z = nodes[variableNode("z")].var;
+		std::vector<statement> init, loop;
+		int bailout = -1;
+		while (peek().kind != token::end && error.empty())
+		{
+			if (peek().kind == token::newline)
+			{
+				pos++;
+				continue;
+			}
+			if (peek().kind != token::name || tokens[pos + 1].text != ":")
+			{
+				fail("expected a section (param:, init:, loop: or bailout:)");
+				break;
+			}
+			const std::string section = peek().text;
+			pos += 2;
+			if (section == "param")
+				parseParameters();
+			else if (section == "init")
+				parseStatements(init);
+			else if (section == "loop")
+				parseStatements(loop);
+			else if (section == "bailout")
+			{
+				while (peek().kind == token::newline)
+					pos++;
+				bailout = parseExpression();
+				while (peek().kind == token::newline)
+					pos++;
+			}
+			else
+				fail("unknown section " + section);
+		}
+		if (error.empty() && bailout < 0)
+			fail("missing bailout section");
+		if (!error.empty())
+		{
+			errorMessage = error;
+			return false;
+		}
+		// the bailout becomes an assignment to a hidden variable
+		const int bailoutVariable = nodes[variableNode(" bailout")].var;
+		std::vector<pendingInstruction> initCode, loopCode, bailoutCode;
+		generate(init, initCode);
+		generate(loop, loopCode);
+		generate({{bailoutVariable, bailout}}, bailoutCode);
+		const int nVariables = (int)program.variables.size();
+		const int nConstants = (int)constantPool.size();
+		const int nRegisters = nVariables + nConstants + maxTemporaries;
+		if (nRegisters > formulaRegisters)
+		{
+			errorMessage = "formula needs more than " + std::to_string(formulaRegisters) + " registers";
+			return false;
+		}
+		link(initCode, program.init);
+		link(loopCode, program.loop);
+		link(bailoutCode, program.bailout);
+		program.initialRegisters.assign(nRegisters, complex(0));
+		for (int ii = 0; ii < nConstants; ii++)
+			program.initialRegisters[nVariables + ii] = constantPool[ii];
+		program.bailoutResult = bailoutVariable;
+		result = program;
+		return true;
+	}
+};
+
+// C++ for one instruction of a formula, register k is r[k]
+inline std::string instructionToCpp(const formulaInstruction &in)
+{
+	const auto r = [](const int k) { return "r[" + std::to_string(k) + "]"; };
+	const std::string a = r(in.a), b = r(in.b), c = r(in.c);
+	std::string value;
+	switch (in.op)
+	{
+		case formulaOp::move: value = a; break;
+		case formulaOp::add: value = a + " + " + b; break;
+		case formulaOp::sub: value = a + " - " + b; break;
+		case formulaOp::mul: value = a + " * " + b; break;
+		case formulaOp::div: value = a + " / " + b; break;
+		case formulaOp::neg: value = "complex(-" + a + ".x, -" + a + ".y)"; break;
+		case formulaOp::sqr: value = a + ".sqr()"; break;
+		case formulaOp::sqrAdd: value = a + ".sqr() + " + b; break;
+		case formulaOp::mulAdd: value = a + " * " + b + " + " + c; break;
+		case formulaOp::powInt: value = "pow(" + a + ", " + std::to_string(in.n) + ")"; break;
+		case formulaOp::pow: value = "(" + b + " * " + a + ".log()).exp()"; break;
+		case formulaOp::abs: value = a + ".abs()"; break;
+		case formulaOp::conj: value = a + ".conj()"; break;
+		case formulaOp::flip: value = a + ".flip()"; break;
+		case formulaOp::exp: value = a + ".exp()"; break;
+		case formulaOp::log: value = a + ".log()"; break;
+		case formulaOp::sin: value = "complexSin(" + a + ")"; break;
+		case formulaOp::cos: value = "complexCos(" + a + ")"; break;
+		case formulaOp::real: value = "complex(" + a + ".x)"; break;
+		case formulaOp::imag: value = "complex(" + a + ".y)"; break;
+		case formulaOp::cabs: value = "complex(" + a + ".cabs())"; break;
+		case formulaOp::norm: value = "complex(" + a + ".cabs_squared())"; break;
+		case formulaOp::makeComplex: value = "complex(" + a + ".x, " + b + ".x)"; break;
+		case formulaOp::less: value = "truth(" + a + ".x < " + b + ".x)"; break;
+		case formulaOp::greater: value = "truth(" + a + ".x > " + b + ".x)"; break;
+		case formulaOp::lessEqual: value = "truth(" + a + ".x <= " + b + ".x)"; break;
+		case formulaOp::greaterEqual: value = "truth(" + a + ".x >= " + b + ".x)"; break;
+		case formulaOp::logicalAnd: value = "truth(" + a + ".x != 0 && " + b + ".x != 0)"; break;
+		case formulaOp::logicalOr: value = "truth(" + a + ".x != 0 || " + b + ".x != 0)"; break;
+		case formulaOp::normLess: value = "truth(" + a + ".cabs_squared() < " + b + ".x)"; break;
+	}
+	return r(in.dst) + " = " + value + ";";
+}
+
+// a formula loaded from source, the orbit state is the register file
+class compiledFormula final : public abstractBaseFractal
+{
+public:
+	formulaProgram program;
+	std::vector<formulaInstruction> iteration; // loop followed by bailout
+	compiledFormula(const formulaProgram &program_) : program(program_)
+	{
+		this->iteration = this->program.loop;
+		this->iteration.insert(this->iteration.end(), this->program.bailout.begin(), this->program.bailout.end());
+	}
+	fractalParameters getParams() const override
+	{
+		fractalParameters params;
+		params.set("maxIter", this->program.maxIter);
+		for (const auto &parameter : this->program.parameters)
+			params.set(parameter.first, parameter.second);
+		return params;
+	}
+	int maxIterations() const override { return this->program.maxIter; }
+	orbitResult orbit(const complex z0) const
+	{
+		complex r[formulaRegisters];
+		std::copy(this->program.initialRegisters.begin(), this->program.initialRegisters.end(), r);
+		r[this->program.pixel] = z0;
+		runFormula(this->program.init.data(), (int)this->program.init.size(), r);
+		// the usual |z| < bailout is tested directly instead of going through a register
+		const formulaInstruction *code = this->iteration.data();
+		const bool normTest = this->program.bailout.size() == 1 && this->program.bailout[0].op == formulaOp::normLess;
+		if (normTest)
+		{
+			const int n = (int)this->program.loop.size();
+			const complex &z = r[this->program.bailout[0].a];
+			const complex &limit = r[this->program.bailout[0].b];
+			for (int iter = 1; iter <= this->program.maxIter; iter++)
+			{
+				runFormula(code, n, r);
+				if (!(z.cabs_squared() < limit.x))
+					return {r[this->program.z], iter, true};
+			}
+			return {r[this->program.z], this->program.maxIter, false};
+		}
+		const int n = (int)this->iteration.size();
+		for (int iter = 1; iter <= this->program.maxIter; iter++)
+		{
+			runFormula(code, n, r);
+			if (r[this->program.bailoutResult].x == 0)
+				return {r[this->program.z], iter, true};
+		}
+		return {r[this->program.z], this->program.maxIter, false};
+	}
+	// orbit() for a whole batch: up to formulaLanes::width orbits run side by
+	// side, lanes that finish are refilled with the next sample
+	static void laneBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+	{
+		constexpr int width = formulaLanes::width;
+		const compiledFormula &formula = static_cast<const compiledFormula&>(fractal);
+		const formulaProgram &program = formula.program;
+		formulaLanes lanes((int)program.initialRegisters.size());
+		int sample[width], iter[width];
+		const auto load = [&](const int lane, const int index)
+		{
+			complex r[formulaRegisters];
+			std::copy(program.initialRegisters.begin(), program.initialRegisters.end(), r);
+			r[program.pixel] = z0[index];
+			runFormula(program.init.data(), (int)program.init.size(), r);
+			for (int k = 0; k < lanes.registers(); k++)
+				lanes.set(k, lane, r[k]);
+			sample[lane] = index;
+			iter[lane] = 0;
+		};
+		int next = 0;
+		int active = 0;
+		while (active < width && next < n)
+			load(active++, next++);
+		const double *bailout = &lanes.x[program.bailoutResult*width];
+		while (active > 0)
+		{
+			runFormulaLanes(formula.iteration.data(), (int)formula.iteration.size(), lanes, active);
+			for (int lane = 0; lane < active; lane++)
+				iter[lane]++;
+			for (int lane = 0; lane < active; )
+			{
+				const bool escaped = bailout[lane] == 0;
+				if (!escaped && iter[lane] < program.maxIter)
+				{
+					lane++;
+					continue;
+				}
+				results[sample[lane]] = {lanes.get(program.z, lane), iter[lane], escaped};
+				if (next < n)
+				{
+					load(lane++, next++);
+					continue;
+				}
+				// the last lane takes this one's place
+				active--;
+				lanes.copyLane(active, lane);
+				sample[lane] = sample[active];
+				iter[lane] = iter[active];
+			}
+		}
+	}
+	static void laneRestart(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+	{
+		laneBatch(fractal, z0, results, n);
+	}
+	orbitKernel kernel() const override { return &laneBatch; }
+	// the G-buffer only keeps z, not the other variables
+	resumeKernel continuation() const override { return &laneRestart; }
+
+	// the program as a formula class for FractalFormulas.h, for building it ahead of time
+	std::string toCpp(const std::string &className) const
+	{
+		std::ostringstream cpp;
+		cpp.precision(17);
+		const int nRegisters = (int)this->program.initialRegisters.size();
+		cpp << "// generated by the formula compiler (FormulaCompiler.h), needs FormulaCompiler.h for its helpers\n"
+			<< "class " << className << " final : public abstractBaseFractal\n{\npublic:\n"
+			<< "\tint maxIter = " << this->program.maxIter << ";\n"
+			<< "\tfractalParameters getParams() const override\n\t{\n\t\tfractalParameters params;\n"
+			<< "\t\tparams.set(\"maxIter\", this->maxIter);\n\t\treturn params;\n\t}\n"
+			<< "\tint maxIterations() const override { return this->maxIter; }\n"
+			<< "\torbitResult orbit(const complex z0) const\n\t{\n"
+			<< "\t\tcomplex r[" << std::max(1, nRegisters) << "] = {";
+		for (int ii = 0; ii < nRegisters; ii++)
+		{
+			const complex &value = this->program.initialRegisters[ii];
+			cpp << ((ii > 0) ? ", " : "") << "complex(" << value.x << ", " << value.y << ")";
+		}
+		cpp << "};\n\t\tr[" << this->program.pixel << "] = z0;\n";
+		for (const formulaInstruction &in : this->program.init)
+			cpp << "\t\t" << instructionToCpp(in) << "\n";
+		cpp << "\t\tfor (int iter = 1; iter <= this->maxIter; iter++)\n\t\t{\n";
+		for (const formulaInstruction &in : this->iteration)
+			cpp << "\t\t\t" << instructionToCpp(in) << "\n";
+		cpp << "\t\t\tif (r[" << this->program.bailoutResult << "].x == 0)\n"
+			<< "\t\t\t\treturn {r[" << this->program.z << "], iter, true};\n\t\t}\n"
+			<< "\t\treturn {r[" << this->program.z << "], this->maxIter, false};\n\t}\n"
+			<< "\torbitKernel kernel() const override { return &orbitBatch<" << className << ">; }\n"
+			<< "\tresumeKernel continuation() const override { return &restartBatch<" << className << ">; }\n"
+			<< "};\n";
+		return cpp.str();
+	}
+};
+
+inline bool isFormulaFile(const std::string &name)
+{
+	return name.size() > 4 && name.compare(name.size() - 4, 4, ".frm") == 0;
+}
+
+// compiles the formula file at path, nullptr (after saying why) if that fails
+inline abstractBaseFractal *loadFormula(const std::string &path)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		std::cout << "Could not open formula " << path << "\n";
+		return nullptr;
+	}
+	std::stringstream source;
+	source << file.rdbuf();
+	formulaProgram program;
+	std::string error;
+	if (!formulaCompiler().compile(source.str(), program, error))
+	{
+		std::cout << path << ": " << error << "\n";
+		return nullptr;
+	}
+	return new compiledFormula(program);
+}
@@ -1,118 +1,398 @@
 #pragma once
 #include <stdio.h>
+#include <array>
+#include <string>
 #include "FractalParameters.h"
+#include "IterationKernel.h"
+#include "SimdKernel.h"
+#include "AttractingCycle.h"
+#include "Perturbation.h"
+#include "Symmetry.h"
 
 /* abstract base class for a fractal formula
    this needs the following ingredients:
    1. parameters of the fractal
    2. initialization (init part in UF) to set initial values
    3. all calculations to iterate
-   4. a bailout check (could be independent, but doesn't have to be)*/
+   4. a bailout check (could be independent, but doesn't have to be)
+   5. the compile time kernels used for rendering and for continuing samples
+      that hit maxIter in an earlier render (see IterationKernel.h)
+   6. optionally a deep zoom mode where samples are offsets from a high
+      precision view center (see Perturbation.h)
+   2. and 3. work on a small orbitState struct of the formula that the kernels
+   keep on the stack: a formula is built once per render, does not change
+   while rendering and is shared by all threads */
 class abstractBaseFractal
 {
 public:
-	fractalParameters params; // holds parameters
 	abstractBaseFractal() {}
-	~abstractBaseFractal() {}
-	virtual fractalParameters getParams() const = 0;
-	virtual complex start(complex z, const complex z0) = 0; // init ini UF
-	virtual complex iterate(complex z, const complex z0) = 0; // loop in UF
-	virtual bool bailoutCheck(const complex z, const int iter) const = 0;
+	virtual ~abstractBaseFractal() {}
+	virtual fractalParameters getParams() const = 0; // by name, for scene files and the UI
+	virtual int maxIterations() const = 0;
+	// updates what is derived from the parameters, call after changing them
+	virtual void prepare() {}
+	virtual orbitKernel kernel() const = 0; // pick once per render, not per sample
+	virtual resumeKernel continuation() const = 0; // continues samples that hit a lower maxIter
+	// switches to deep zoom kernels (call before kernel()), false if the formula has none
+	virtual bool setDeepZoom(const deepZoomView &view) { return false; }
+	// single precision kernels for shallow views (see singlePrecisionSuffices),
+	// false if the formula has none
+	virtual bool setSinglePrecision(const bool enable) { return false; }
+	// iteration and BLA skip counts of deep zoom renders, nullptr otherwise
+	virtual const blaCounters *deepZoomCounters() const { return nullptr; }
+	// symmetry of the set in the complex plane, lets symmetric views render half the pixels
+	virtual setSymmetry symmetry() const { return setSymmetry::none; }
+	// no holes in the interior, subdivision may fill regions enclosed by it (BoundaryTracing.h)
+	virtual bool simplyConnectedInterior() const { return false; }
 };
 
 
 // FRACTAL FORMULAS AS DERIVED CLASSES 
 
+// iteration counts have to fit the 29 bits a G-buffer sample has for them (GBuffer.h)
+constexpr int maxIterLimit = (1 << 29) - 1;
+// deep zoom reference orbits are iterated in bigFixed, which wraps at 2^32
+// (BigFixed.h); |z|^2 < bailout before a step keeps z^2 + c below bailout + |c|
+constexpr double maxBailout = 1u << 31;
+
 // Mandelbrot Set
-class MandelbrotSet : public abstractBaseFractal
+class MandelbrotSet final : public abstractBaseFractal
 {
 public:
-	fractalParameters params;
 	int maxIter = 250;
-	int exponent = 2;
-	double bailout = 100000000000000000000.;
-	// default constructor
-	MandelbrotSet() {
-		this->bailout = 128.;
-		this->maxIter = 250;
-		this->exponent = 2;
+	int exponent = 2; // fixed, see Multibrot for other powers
+	double bailout = 128.;
+	double periodicityTolerance = 1e-12; // orbits returning this close to an earlier z are cyclic
+	deepZoomKernel deepZoom = deepZoomKernel::none; // deep zoom samples are offsets from view.center
+	bool singlePrecision = false; // float SIMD kernels for shallow views
+	deepZoomView view;
+	perturbationReference reference;
+	static constexpr std::array<parameterDescriptor<MandelbrotSet>, 4> schema()
+	{
+		return {{
+			integerParameter("maxIter", &MandelbrotSet::maxIter, 1, maxIterLimit),
+			integerParameter("exponent", &MandelbrotSet::exponent, 2, 2),
+			realParameter("bailout", &MandelbrotSet::bailout, 4, maxBailout),
+			realParameter("periodicityTolerance", &MandelbrotSet::periodicityTolerance, 0, 1),
+		}};
+	}
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	struct orbitState { complex z; };
+	void start(orbitState &state, const complex z0) const { state.z = z0; }
+	void iterate(orbitState &state, const complex z0) const { state.z = state.z * state.z + z0; }
+	bailoutState bailoutCheck(const complex z, const int iter) const
+	{
+		return (z.cabs_squared() < this->bailout) ? bailoutState::iterating : bailoutState::escaped;
+	}
+	quadraticSettings settings() const
+	{
+		return {this->maxIter, this->bailout, this->periodicityTolerance, true};
+	}
+	orbitResult orbit(const complex z0) const
+	{
+		if (inMainCardioidOrBulb(z0))
+			return {z0, 0, false, true};
+		return quadraticOrbit(z0, z0, this->settings());
+	}
+	orbitResult resume(const complex z0, const complex zFrom, const int iterFrom) const
+	{
+		orbitResult result = quadraticOrbit(zFrom, z0, resumedSettings(this->settings(), iterFrom));
+		result.iter += iterFrom;
+		return result;
+	}
+	static void simdBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+	{
+		const MandelbrotSet &formula = static_cast<const MandelbrotSet&>(fractal);
+		const quadraticBatchFunction batch = (formula.singlePrecision) ? quadraticBatchSingle() : quadraticBatch();
+		batch(z0, z0, 1, results, n, formula.settings());
+	}
+	static void simdResume(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+	{
+		const MandelbrotSet &formula = static_cast<const MandelbrotSet&>(fractal);
+		quadraticBatch()(zFrom, z0, 1, results, n, resumedSettings(formula.settings(), iterFrom));
+		addIterations(results, n, iterFrom);
 	}
-	MandelbrotSet(fractalParameters params_)
+	bool setDeepZoom(const deepZoomView &view_) override
 	{
-		this->maxIter = params_.integerParameters["maxIter"];
-		this->exponent = params_.integerParameters["exponent"];
-		this->bailout = params_.doubleParameters["bailout"];
+		this->view = view_;
+		this->deepZoom = deepZoomKernelFor(this->view);
+		if (this->deepZoom == deepZoomKernel::perturbation)
+			this->reference = mandelbrotReference(this->view, this->maxIter, this->bailout);
+		return true;
 	}
-	fractalParameters getParams() const override {
-		fractalParameters params;
-		params.integerParameters["maxIter"] = this->maxIter;
-		params.integerParameters["exponent"] = this->exponent;
-		params.doubleParameters["bailout"] = this->bailout;
-		return params;
+	const blaCounters *deepZoomCounters() const override
+	{
+		return (this->deepZoom == deepZoomKernel::perturbation) ? this->reference.counters.get() : nullptr;
 	}
-	complex start(complex z, const complex z0) override
+	setSymmetry symmetry() const override { return setSymmetry::conjugate; }
+	bool simplyConnectedInterior() const override { return true; }
+	bool setSinglePrecision(const bool enable) override
 	{
-		z = z0;
-		return z;
+		this->singlePrecision = enable && quadraticBatchSingle() != nullptr;
+		return this->singlePrecision;
 	}
-	complex iterate(complex z, const complex z0) override
+	quadraticSettings deepZoomSettings() const { return {this->maxIter, this->bailout}; }
+	template <class T>
+	orbitResult deepOrbit(const complexT<T> &z0) const
 	{
-		z = z * z + z0;
-		return z;
+		return quadraticOrbit(z0, z0, this->deepZoomSettings());
 	}
-	bool bailoutCheck(const complex z, const int iter) const override
+	orbitKernel kernel() const override
 	{
-		return (z.cabs_squared() < this->bailout) ? false : true;
+		switch (this->deepZoom)
+		{
+			case deepZoomKernel::perturbation: return &perturbationBatch<MandelbrotSet>;
+			case deepZoomKernel::doubleDouble: return &multiPrecisionBatch<MandelbrotSet, doubleDouble>;
+			case deepZoomKernel::quadDouble: return &multiPrecisionBatch<MandelbrotSet, quadDouble>;
+			default: break;
+		}
+		return (detectSimdLevel() != simdLevel::scalar) ? &simdBatch : &orbitBatch<MandelbrotSet>;
+	}
+	resumeKernel continuation() const override
+	{
+		switch (this->deepZoom)
+		{
+			case deepZoomKernel::perturbation: return &perturbationResumeBatch<MandelbrotSet>;
+			case deepZoomKernel::doubleDouble: return &multiPrecisionResumeBatch<MandelbrotSet, doubleDouble>;
+			case deepZoomKernel::quadDouble: return &multiPrecisionResumeBatch<MandelbrotSet, quadDouble>;
+			default: break;
+		}
+		return (detectSimdLevel() != simdLevel::scalar) ? &simdResume : &resumeBatch<MandelbrotSet>;
 	}
 };
 
 // Mandelbrot Set
-class JuliaSet : public abstractBaseFractal
+class JuliaSet final : public abstractBaseFractal
 {
 public:
-	fractalParameters params;
 	int maxIter = 2500;
-	int exponent = 2;
-	double bailout = 100000000000000000000.;
+	int exponent = 2; // fixed, see MultiJulia for other powers
+	double bailout = 128.;
 	complex seed = complex(-0.4, 0.6);
+	// attracting cycle of the seed, found once per render (period and multiplier
+	// can be used for interior colouring)
+	attractingCycle cycle;
+	deepZoomKernel deepZoom = deepZoomKernel::none; // deep zoom samples are offsets from view.center
+	bool singlePrecision = false; // float SIMD kernels for shallow views
+	deepZoomView view;
+	perturbationReference reference;
 	// default constructor
 	JuliaSet() {
-		this->bailout = 128.;
-		this->maxIter = 2500;
-		this->exponent = 2;
-		this->seed = complex(-0.4, 0.6);
+		this->prepare();
+	}
+	static constexpr std::array<parameterDescriptor<JuliaSet>, 4> schema()
+	{
+		return {{
+			integerParameter("maxIter", &JuliaSet::maxIter, 1, maxIterLimit),
+			integerParameter("exponent", &JuliaSet::exponent, 2, 2),
+			realParameter("bailout", &JuliaSet::bailout, 4, maxBailout),
+			complexParameter("seed", &JuliaSet::seed, -4, 4),
+		}};
+	}
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	void prepare() override { this->cycle = findAttractingCycle(this->seed); }
+	struct orbitState { complex z; };
+	void start(orbitState &state, const complex z0) const { state.z = z0; }
+	void iterate(orbitState &state, const complex z0) const { state.z = state.z * state.z + this->seed; }
+	bailoutState bailoutCheck(const complex z, const int iter) const
+	{
+		return (z.cabs_squared() < this->bailout) ? bailoutState::iterating : bailoutState::escaped;
+	}
+	quadraticSettings settings() const
+	{
+		quadraticSettings settings{this->maxIter, this->bailout};
+		if (this->cycle.found)
+		{
+			settings.trapCenter = this->cycle.point;
+			settings.trapRadius = this->cycle.radius;
+		}
+		return settings;
+	}
+	orbitResult orbit(const complex z0) const
+	{
+		return quadraticOrbit(z0, this->seed, this->settings());
+	}
+	orbitResult resume(const complex z0, const complex zFrom, const int iterFrom) const
+	{
+		orbitResult result = quadraticOrbit(zFrom, this->seed, resumedSettings(this->settings(), iterFrom));
+		result.iter += iterFrom;
+		return result;
+	}
+	static void simdBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+	{
+		const JuliaSet &formula = static_cast<const JuliaSet&>(fractal);
+		const quadraticBatchFunction batch = (formula.singlePrecision) ? quadraticBatchSingle() : quadraticBatch();
+		batch(z0, &formula.seed, 0, results, n, formula.settings());
+	}
+	static void simdResume(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+	{
+		const JuliaSet &formula = static_cast<const JuliaSet&>(fractal);
+		quadraticBatch()(zFrom, &formula.seed, 0, results, n, resumedSettings(formula.settings(), iterFrom));
+		addIterations(results, n, iterFrom);
+	}
+	bool setDeepZoom(const deepZoomView &view_) override
+	{
+		this->view = view_;
+		this->deepZoom = deepZoomKernelFor(this->view);
+		if (this->deepZoom == deepZoomKernel::perturbation)
+			this->reference = juliaReference(this->view, this->seed, this->maxIter, this->bailout);
+		return true;
 	}
-	JuliaSet(fractalParameters params_)
+	const blaCounters *deepZoomCounters() const override
 	{
-		this->maxIter = params_.integerParameters["maxIter"];
-		this->exponent = params_.integerParameters["exponent"];
-		this->bailout = params_.doubleParameters["bailout"];
-		this->seed = params_.complexParameters["seed"];
+		return (this->deepZoom == deepZoomKernel::perturbation) ? this->reference.counters.get() : nullptr;
 	}
-	fractalParameters getParams() const override {
-		fractalParameters params;
-		params.integerParameters["maxIter"] = this->maxIter;
-		params.integerParameters["exponent"] = this->exponent;
-		params.doubleParameters["bailout"] = this->bailout;
-		params.complexParameters["seed"] = this->seed;
-		return params;
+	// quadratic Julia sets are symmetric under z -> -z
+	setSymmetry symmetry() const override { return setSymmetry::origin; }
+	// only connected for seeds in the Mandelbrot set, an attracting cycle proves that
+	bool simplyConnectedInterior() const override { return this->cycle.found; }
+	bool setSinglePrecision(const bool enable) override
+	{
+		this->singlePrecision = enable && quadraticBatchSingle() != nullptr;
+		return this->singlePrecision;
 	}
-	complex start(complex z, const complex z0) override
+	quadraticSettings deepZoomSettings() const { return this->settings(); }
+	template <class T>
+	orbitResult deepOrbit(const complexT<T> &z0) const
 	{
-		z = z0;
-		return z;
+		return quadraticOrbit(z0, complexT<T>(this->seed), this->deepZoomSettings());
 	}
-	complex iterate(complex z, const complex z0) override
+	orbitKernel kernel() const override
 	{
-		z = z * z + this->seed;
-		return z;
+		switch (this->deepZoom)
+		{
+			case deepZoomKernel::perturbation: return &perturbationBatch<JuliaSet>;
+			case deepZoomKernel::doubleDouble: return &multiPrecisionBatch<JuliaSet, doubleDouble>;
+			case deepZoomKernel::quadDouble: return &multiPrecisionBatch<JuliaSet, quadDouble>;
+			default: break;
+		}
+		return (detectSimdLevel() != simdLevel::scalar) ? &simdBatch : &orbitBatch<JuliaSet>;
 	}
-	bool bailoutCheck(const complex z, const int iter) const override
+	resumeKernel continuation() const override
 	{
-		return (z.cabs_squared() < this->bailout) ? false : true;
+		switch (this->deepZoom)
+		{
+			case deepZoomKernel::perturbation: return &perturbationResumeBatch<JuliaSet>;
+			case deepZoomKernel::doubleDouble: return &multiPrecisionResumeBatch<JuliaSet, doubleDouble>;
+			case deepZoomKernel::quadDouble: return &multiPrecisionResumeBatch<JuliaSet, quadDouble>;
+			default: break;
+		}
+		return (detectSimdLevel() != simdLevel::scalar) ? &simdResume : &resumeBatch<JuliaSet>;
 	}
 };
 
+// Multibrot sets: z -> z^exponent + c, the power is unrolled at compile time
+// up to maxUnrolledPower (Complex.h)
+class Multibrot final : public abstractBaseFractal
+{
+public:
+	int maxIter = 250;
+	int exponent = 3;
+	double bailout = 128.;
+	double periodicityTolerance = 1e-12; // orbits returning this close to an earlier z are cyclic
+	static constexpr std::array<parameterDescriptor<Multibrot>, 4> schema()
+	{
+		return {{
+			integerParameter("maxIter", &Multibrot::maxIter, 1, maxIterLimit),
+			integerParameter("exponent", &Multibrot::exponent, 2, 64),
+			realParameter("bailout", &Multibrot::bailout, 4),
+			realParameter("periodicityTolerance", &Multibrot::periodicityTolerance, 0, 1),
+		}};
+	}
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	struct orbitState { complex z; };
+	void start(orbitState &state, const complex z0) const { state.z = z0; }
+	void iterate(orbitState &state, const complex z0) const { state.z = pow(state.z, this->exponent) + z0; }
+	bailoutState bailoutCheck(const complex z, const int iter) const
+	{
+		return (z.cabs_squared() < this->bailout) ? bailoutState::iterating : bailoutState::escaped;
+	}
+	quadraticSettings settings() const
+	{
+		return {this->maxIter, this->bailout, this->periodicityTolerance};
+	}
+	template <int N>
+	orbitResult orbit(const complex z0) const
+	{
+		return powerOrbit<N>(z0, z0, this->exponent, this->settings());
+	}
+	template <int N>
+	orbitResult resume(const complex z0, const complex zFrom, const int iterFrom) const
+	{
+		orbitResult result = powerOrbit<N>(zFrom, z0, this->exponent, resumedSettings(this->settings(), iterFrom));
+		result.iter += iterFrom;
+		return result;
+	}
+	setSymmetry symmetry() const override { return setSymmetry::conjugate; }
+	// connectedness loci have no holes, just like the Mandelbrot set
+	bool simplyConnectedInterior() const override { return true; }
+	orbitKernel kernel() const override { return powerKernel<Multibrot>(this->exponent); }
+	resumeKernel continuation() const override { return powerContinuation<Multibrot>(this->exponent); }
+};
+
+// Julia sets of z -> z^exponent + seed
+class MultiJulia final : public abstractBaseFractal
+{
+public:
+	int maxIter = 2500;
+	int exponent = 3;
+	double bailout = 128.;
+	double periodicityTolerance = 1e-12; // orbits returning this close to an earlier z are cyclic
+	complex seed = complex(-0.1, 0.65);
+	bool connected = false; // the critical orbit stays bounded for maxIter iterations
+	MultiJulia() {
+		this->prepare();
+	}
+	static constexpr std::array<parameterDescriptor<MultiJulia>, 5> schema()
+	{
+		return {{
+			integerParameter("maxIter", &MultiJulia::maxIter, 1, maxIterLimit),
+			integerParameter("exponent", &MultiJulia::exponent, 2, 64),
+			realParameter("bailout", &MultiJulia::bailout, 4),
+			realParameter("periodicityTolerance", &MultiJulia::periodicityTolerance, 0, 1),
+			complexParameter("seed", &MultiJulia::seed, -4, 4),
+		}};
+	}
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	// 0 is the only critical point, the Julia set is connected if its orbit is bounded
+	void prepare() override
+	{
+		this->connected = !powerOrbit<runtimePower>(complex(0), this->seed, this->exponent, this->settings()).bailedOut;
+	}
+	struct orbitState { complex z; };
+	void start(orbitState &state, const complex z0) const { state.z = z0; }
+	void iterate(orbitState &state, const complex z0) const { state.z = pow(state.z, this->exponent) + this->seed; }
+	bailoutState bailoutCheck(const complex z, const int iter) const
+	{
+		return (z.cabs_squared() < this->bailout) ? bailoutState::iterating : bailoutState::escaped;
+	}
+	quadraticSettings settings() const
+	{
+		return {this->maxIter, this->bailout, this->periodicityTolerance};
+	}
+	template <int N>
+	orbitResult orbit(const complex z0) const
+	{
+		return powerOrbit<N>(z0, this->seed, this->exponent, this->settings());
+	}
+	template <int N>
+	orbitResult resume(const complex z0, const complex zFrom, const int iterFrom) const
+	{
+		orbitResult result = powerOrbit<N>(zFrom, this->seed, this->exponent, resumedSettings(this->settings(), iterFrom));
+		result.iter += iterFrom;
+		return result;
+	}
+	// symmetric under rotations by 2 pi / exponent, which includes z -> -z for even powers
+	setSymmetry symmetry() const override { return (this->exponent % 2 == 0) ? setSymmetry::origin : setSymmetry::none; }
+	bool simplyConnectedInterior() const override { return this->connected; }
+	orbitKernel kernel() const override { return powerKernel<MultiJulia>(this->exponent); }
+	resumeKernel continuation() const override { return powerContinuation<MultiJulia>(this->exponent); }
+};
+
 // // Burning Ship
 // class BurningShip : public abstractBaseFractal
 // {
@@ -173,139 +453,152 @@ public:
 // 	}
 // };
 
-// // Mandelbrot Set
-// class Manowar : public abstractBaseFractal
-// {
-// public:
-// 	struct variables
-// 	{
-// 		complex zold;
-// 		complex z1;
-// 	};
-// 	fractalParameters params;
-// 	variables vars;
-// 	// integer parameters
-// 	int maxIter = 250;
-// 	int exponent = 2;
-// 	// double parameters
-// 	double bailout = 120.;
-// 	// complex parameters
-// 	// default constructor
-// 	Manowar() {
-// 		this->params.doubleParameters["bailout"] = 128.;
-// 		this->params.integerParameters["maxIter"] = 250;
-// 		this->params.integerParameters["exponent"] = 2;
-// 	}
-// 	Manowar(fractalParameters params_)
-// 	{
-// 		this->params = params_;	
-// 	}
-// 	fractalParameters getParams() const {
-// 		return this->params;"] 
-// "] 
-// "] 
-// "] 
-// 	}
-// 	complex start(complex z, const complex z0) override
-// 	{
-// 		z = z0;
-// 	}
-// 	complex iterate(complex z, const complex z0) override
-// 	{
-// 		this->vars.zold = z;
-// 		z = z * z + this->vars.z1 + z0;
-// 		this->vars.z1 = this->vars.zold;
-// 	}
-// 	bool bailoutCheck(const complex z, const int iter) const override
-// 	{
-// 		bailedOut = (z.cabs_squared() < 4. && iter < maxIter) ? false : true;
-// 	}
-// };
+// Manowar: z -> z^2 + z1 + c with z1 the z of the iteration before
+class Manowar final : public abstractBaseFractal
+{
+public:
+	// integer parameters
+	int maxIter = 250;
+	// double parameters
+	double bailout = 128.;
+	static constexpr std::array<parameterDescriptor<Manowar>, 2> schema()
+	{
+		return {{
+			integerParameter("maxIter", &Manowar::maxIter, 1, maxIterLimit),
+			realParameter("bailout", &Manowar::bailout, 4, maxBailout),
+		}};
+	}
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	struct orbitState
+	{
+		complex z;
+		complex z1; // z of the iteration before
+	};
+	void start(orbitState &state, const complex z0) const
+	{
+		state.z = z0;
+		state.z1 = z0;
+	}
+	void iterate(orbitState &state, const complex z0) const
+	{
+		const complex zold = state.z;
+		state.z = state.z * state.z + state.z1 + z0;
+		state.z1 = zold;
+	}
+	bailoutState bailoutCheck(const complex z, const int iter) const
+	{
+		return (z.cabs_squared() < this->bailout) ? bailoutState::iterating : bailoutState::escaped;
+	}
+	orbitResult orbit(const complex z0) const
+	{
+		return genericOrbit(*this, z0, this->maxIter);
+	}
+	setSymmetry symmetry() const override { return setSymmetry::conjugate; }
+	orbitKernel kernel() const override { return &orbitBatch<Manowar>; }
+	// the G-buffer only keeps z, not z1
+	resumeKernel continuation() const override { return &restartBatch<Manowar>; }
+};
 
 // Draw a grid with selected spacings and width
-class Grid : public abstractBaseFractal
+class Grid final : public abstractBaseFractal
 {
 public:
-	fractalParameters params;
 	// integer parameters
-	int maxIter = 250;
+	int maxIter = 2; // not strictly necessary but allows to color "inside" points
 	// double parameters
-	double GridWidth = 0.01;
+	double GridWidth = 0.02;
 	double GridX = 0.2;
 	double GridY = 0.2;
 	// complex parameters
-	// default constructor
-	Grid() {
-		this->GridWidth = 0.02;
-		this->maxIter = 2; // not strictly necessary but allows to color "inside" points
-		this->GridX = 0.2;
-		this->GridY = 0.2;
-	}
-	Grid(fractalParameters params_)
+	static constexpr std::array<parameterDescriptor<Grid>, 4> schema()
 	{
-		this->GridWidth = params_.doubleParameters["GridWidth"];
-		this->maxIter = params_.integerParameters["maxIter"]; // not strictly necessary but allows to color "inside" points
-		this->GridX = params_.doubleParameters["GridX"];
-		this->GridY = params_.doubleParameters["GridY"];
-	}
-	~Grid() {}
-	fractalParameters getParams() const override {
-		fractalParameters params;
-		params.integerParameters["maxIter"] = this->maxIter;
-		params.doubleParameters["GridWith"] = this->GridWidth;
-		params.doubleParameters["GridX"] = this->GridX;
-		params.doubleParameters["GridY"] = this->GridY;
-		return params;
+		return {{
+			integerParameter("maxIter", &Grid::maxIter, 1, maxIterLimit),
+			realParameter("GridWidth", &Grid::GridWidth, 0),
+			realParameter("GridX", &Grid::GridX, 1e-300),
+			realParameter("GridY", &Grid::GridY, 1e-300),
+		}};
 	}
-	complex start(complex z, const complex z0) override
+	fractalParameters getParams() const override { return getParameters(*this); }
+	int maxIterations() const override { return this->maxIter; }
+	struct orbitState { complex z; };
+	void start(orbitState &state, const complex z0) const { state.z = z0; }
+	void iterate(orbitState &state, const complex z0) const {} // yeah... I know D: 
+	double wrapToRange1d(const double x, const double y) const { return x - y * floor(x / y); }
+	bailoutState bailoutCheck(const complex z, const int iter) const
 	{
-		z = z0;
-		return z;
+		return (std::min(wrapToRange1d(z.x, this->GridX), wrapToRange1d(z.y, this->GridY)) < this->GridWidth && iter < this->maxIter) ? bailoutState::iterating : bailoutState::escaped;
 	}
-	complex iterate(complex z, const complex z0) override
+	orbitResult orbit(const complex z0) const
 	{
-		return z; // yeah... I know D: 
+		return genericOrbit(*this, z0, this->maxIter);
 	}
-	double wrapToRange1d(const double x, const double y) const { return x - y * floor(x / y); }
-	bool bailoutCheck(const complex z, const int iter) const override
+	orbitResult resume(const complex z0, const complex zFrom, const int iterFrom) const
 	{
-		return (std::min(wrapToRange1d(z.x, this->GridX), wrapToRange1d(z.y, this->GridY)) < this->GridWidth && iter < this->maxIter) ? false : true;
+		return genericOrbit(*this, z0, this->maxIter, orbitState{zFrom}, iterFrom);
 	}
+	orbitKernel kernel() const override { return &orbitBatch<Grid>; }
+	resumeKernel continuation() const override { return &resumeBatch<Grid>; }
 };
 
 abstractBaseFractal *getFractal(std::string FractalName)
 {
 	if (FractalName == "MandelbrotSet")
 		return new MandelbrotSet();
-	// else if (FractalName == "JuliaSet")
-	// 	return new JuliaSet();
+	else if (FractalName == "JuliaSet")
+		return new JuliaSet();
+	else if (FractalName == "Multibrot")
+		return new Multibrot();
+	else if (FractalName == "MultiJulia")
+		return new MultiJulia();
 	// else if (FractalName == "BurningShip")
 	// 	return new BurningShip();
 	// else if (FractalName == "BurningShipJulia")
 	// 	return new BurningShipJulia();
-	// else if (FractalName == "Manowar")
-	// 	return new Manowar();
+	else if (FractalName == "Manowar")
+		return new Manowar();
 	else if (FractalName == "Grid")
 	    return new Grid();
 	else
 		return nullptr;
 }
 
+// default formula with the values of params, nullptr (after saying why) if
+// params does not fit its schema
+template <class Formula>
+abstractBaseFractal *makeFractal(const fractalParameters &params)
+{
+	Formula *fractal = new Formula();
+	std::string error;
+	if (!setParameters(*fractal, params, error))
+	{
+		std::cout << "Invalid parameters: " << error << "\n";
+		delete fractal;
+		return nullptr;
+	}
+	fractal->prepare();
+	return fractal;
+}
+
 abstractBaseFractal *getFractal(std::string FractalName, fractalParameters params)
 {
-	std::cout << "Called two parameter version of the factory\n";
 	if (FractalName == "MandelbrotSet")
-		return new MandelbrotSet(params);
-	// else if (FractalName == "JuliaSet")
-	// 	return new JuliaSet(params);
+		return makeFractal<MandelbrotSet>(params);
+	else if (FractalName == "JuliaSet")
+		return makeFractal<JuliaSet>(params);
+	else if (FractalName == "Multibrot")
+		return makeFractal<Multibrot>(params);
+	else if (FractalName == "MultiJulia")
+		return makeFractal<MultiJulia>(params);
 	// else if (FractalName == "BurningShip")
 	// 	return new BurningShip(params);
 	// else if (FractalName == "BurningShipJulia")
 	// 	return new BurningShipJulia(params);
-	// else if (FractalName == "Manowar")
-	// 	return new Manowar();
+	else if (FractalName == "Manowar")
+		return makeFractal<Manowar>(params);
 	else if (FractalName == "Grid")
-	    return new Grid();
+	    return makeFractal<Grid>(params);
 	else
 		return nullptr;
 }
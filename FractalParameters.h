@@ -1,13 +1,156 @@
 #pragma once
+#include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include "Complex.h"
 
+/* Typed fractal parameters
 
-// make a boilerplate template for fractal parameters with some flexibility
-struct fractalParameters
+   A formula keeps its parameters as plain members (their initializers are
+   the defaults) and describes them once in a static schema(): name, type,
+   member and allowed range. Kernels only ever read the members. Name based
+   access is for scene files and the UI: fractalParameters is a bag of named
+   values that getParameters() fills from a formula and setParameters()
+   checks against the schema and copies into one. Parameters that are not in
+   the bag keep their default, unknown names, values of the wrong type and
+   values out of range are errors. */
+
+enum class parameterType { integer, real, complexNumber };
+
+struct parameterValue
+{
+	parameterType type = parameterType::real;
+	int integer = 0;
+	double real = 0;
+	complex complexValue = complex(0);
+};
+
+// named parameter values, e.g. read from a scene file
+class fractalParameters
+{
+private:
+	std::map<std::string, parameterValue> values;
+public:
+	void set(const std::string &name, const int value) { values[name] = {parameterType::integer, value}; }
+	void set(const std::string &name, const double value) { values[name] = {parameterType::real, 0, value}; }
+	void set(const std::string &name, const complex &value) { values[name] = {parameterType::complexNumber, 0, 0, value}; }
+	// nullptr if name was never set
+	const parameterValue *find(const std::string &name) const
+	{
+		const auto it = values.find(name);
+		return (it == values.end()) ? nullptr : &it->second;
+	}
+	const std::map<std::string, parameterValue> &all() const { return values; }
+};
+
+// one parameter of Formula, the member pointer matching type is set; both
+// components of complex parameters must lie in [minimum, maximum]
+template <class Formula>
+struct parameterDescriptor
+{
+	const char *name;
+	parameterType type;
+	int Formula::*integerMember;
+	double Formula::*realMember;
+	complex Formula::*complexMember;
+	double minimum;
+	double maximum;
+};
+
+template <class Formula>
+constexpr parameterDescriptor<Formula> integerParameter(const char *name, int Formula::*member,
+	const double minimum, const double maximum)
+{
+	return {name, parameterType::integer, member, nullptr, nullptr, minimum, maximum};
+}
+
+template <class Formula>
+constexpr parameterDescriptor<Formula> realParameter(const char *name, double Formula::*member,
+	const double minimum, const double maximum = std::numeric_limits<double>::max())
+{
+	return {name, parameterType::real, nullptr, member, nullptr, minimum, maximum};
+}
+
+template <class Formula>
+constexpr parameterDescriptor<Formula> complexParameter(const char *name, complex Formula::*member,
+	const double minimum, const double maximum)
+{
+	return {name, parameterType::complexNumber, nullptr, nullptr, member, minimum, maximum};
+}
+
+template <class Formula>
+fractalParameters getParameters(const Formula &formula)
+{
+	fractalParameters params;
+	for (const parameterDescriptor<Formula> &p : Formula::schema())
+	{
+		switch (p.type)
+		{
+			case parameterType::integer: params.set(p.name, formula.*p.integerMember); break;
+			case parameterType::real: params.set(p.name, formula.*p.realMember); break;
+			case parameterType::complexNumber: params.set(p.name, formula.*p.complexMember); break;
+		}
+	}
+	return params;
+}
+
+// false (and the reason in error) if params has a name Formula does not know
+// or a value of the wrong type or out of range, formula is unchanged then
+template <class Formula>
+bool setParameters(Formula &formula, const fractalParameters &params, std::string &error)
 {
-	std::map<std::string, int> integerParameters;
-	std::map<std::string, double> doubleParameters;
-	std::map<std::string, complex> complexParameters;
-};
\ No newline at end of file
+	const auto &schema = Formula::schema();
+	for (const auto &entry : params.all())
+	{
+		const parameterDescriptor<Formula> *p = nullptr;
+		for (const parameterDescriptor<Formula> &candidate : schema)
+		{
+			if (entry.first == candidate.name)
+				p = &candidate;
+		}
+		if (p == nullptr)
+		{
+			error = "unknown parameter " + entry.first;
+			return false;
+		}
+		const parameterValue &value = entry.second;
+		// integers are accepted for real parameters
+		const bool typeMatches = value.type == p->type
+			|| (value.type == parameterType::integer && p->type == parameterType::real);
+		if (!typeMatches)
+		{
+			error = "parameter " + entry.first + " has the wrong type";
+			return false;
+		}
+		const auto inRange = [p](const double x) { return x >= p->minimum && x <= p->maximum; };
+		const double real = (value.type == parameterType::integer) ? value.integer : value.real;
+		const bool valid = (p->type == parameterType::complexNumber)
+			? inRange(value.complexValue.x) && inRange(value.complexValue.y) : inRange(real);
+		if (!valid)
+		{
+			std::ostringstream message;
+			message << "parameter " << entry.first << " is out of range [" << p->minimum << ", " << p->maximum << "]";
+			error = message.str();
+			return false;
+		}
+	}
+	for (const auto &entry : params.all())
+	{
+		for (const parameterDescriptor<Formula> &p : schema)
+		{
+			if (entry.first != p.name)
+				continue;
+			const parameterValue &value = entry.second;
+			switch (p.type)
+			{
+				case parameterType::integer: formula.*p.integerMember = value.integer; break;
+				case parameterType::real:
+					formula.*p.realMember = (value.type == parameterType::integer) ? value.integer : value.real;
+					break;
+				case parameterType::complexNumber: formula.*p.complexMember = value.complexValue; break;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "IterationKernel.h"
+#include "color.h"
+
+/* G-buffer: per sample iteration results on disk
+
+   Stores iteration count, final z and bailout flags of every sample in a
+   memory mapped file, so a separate colouring stage can turn a finished
+   render into RGB again (other gradient, other mapping) without iterating.
+   Samples are stored pixel major: all samples of pixel 0, then pixel 1, ...
+   A sample takes 12 bytes, plan the disk space accordingly
+   (width * height * samplesPerPixel * 12 bytes).
+
+   Samples that hit maxIter are also written to a sidecar file (G-buffer path
+   + ".capped") with their coordinate and full precision z. After raising
+   maxIter, continueCappedSamples() resumes only those from where they
+   stopped and updates their G-buffer entries, everything that escaped
+   earlier is reused as is. */
+
+struct gSample
+{
+	float zx, zy; // final z (float is plenty for colouring)
+	uint32_t state; // iteration count in the low bits, flags on top
+
+	static constexpr uint32_t escapedFlag = 1u << 31;
+	static constexpr uint32_t insideFlag  = 1u << 30;
+	static constexpr uint32_t validFlag   = 1u << 29; // slot was written (adaptive renders leave gaps)
+	static constexpr uint32_t iterMask    = validFlag - 1;
+
+	static gSample fromResult(const orbitResult &result)
+	{
+		uint32_t state = ((uint32_t)result.iter & iterMask) | validFlag;
+		state |= (result.bailedOut) ? escapedFlag : 0;
+		state |= (result.inside) ? insideFlag : 0;
+		return {(float)result.z.x, (float)result.z.y, state};
+	}
+	bool valid() const { return (state & validFlag) != 0; }
+	bool bailedOut() const { return (state & escapedFlag) != 0; }
+	bool inside() const { return (state & insideFlag) != 0; }
+	int iter() const { return (int)(state & iterMask); }
+};
+
+struct gBufferHeader
+{
+	char magic[8];
+	int32_t width;
+	int32_t height;
+	int32_t samplesPerPixel;
+	int32_t maxIter;
+};
+
+class gBuffer
+{
+private:
+	int fd = -1;
+	size_t mappedSize = 0;
+	void *mapped = nullptr;
+	gBufferHeader *header = nullptr;
+	gSample *samples = nullptr;
+	static constexpr char magicString[8] = {'M', 'B', 'G', 'B', 'U', 'F', '1', '\0'};
+
+	bool map(const int protection)
+	{
+		mapped = mmap(nullptr, mappedSize, protection, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			mapped = nullptr;
+			return false;
+		}
+		header = (gBufferHeader*)mapped;
+		samples = (gSample*)((char*)mapped + sizeof(gBufferHeader));
+		return true;
+	}
+
+public:
+	gBuffer() {}
+	gBuffer(const gBuffer&) = delete;
+	gBuffer& operator=(const gBuffer&) = delete;
+	~gBuffer() { close(); }
+
+	// create (or overwrite) a G-buffer file, all samples start out invalid
+	bool create(const std::string &path, const int width, const int height, const int samplesPerPixel, const int maxIter)
+	{
+		close();
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0)
+			return false;
+		mappedSize = sizeof(gBufferHeader) + sizeof(gSample) * (size_t)width * height * samplesPerPixel;
+		if (ftruncate(fd, mappedSize) != 0 || !map(PROT_READ | PROT_WRITE))
+		{
+			close();
+			return false;
+		}
+		std::memcpy(header->magic, magicString, sizeof(magicString));
+		header->width = width;
+		header->height = height;
+		header->samplesPerPixel = samplesPerPixel;
+		header->maxIter = maxIter;
+		return true;
+	}
+
+	// open an existing G-buffer, writable so continued renders can update it
+	bool open(const std::string &path, const bool writable = false)
+	{
+		close();
+		fd = ::open(path.c_str(), (writable) ? O_RDWR : O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(gBufferHeader))
+		{
+			close();
+			return false;
+		}
+		mappedSize = info.st_size;
+		if (!map((writable) ? PROT_READ | PROT_WRITE : PROT_READ) || std::memcmp(header->magic, magicString, sizeof(magicString)) != 0
+			|| mappedSize != sizeof(gBufferHeader) + sizeof(gSample) * (size_t)header->width * header->height * header->samplesPerPixel)
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close()
+	{
+		if (mapped != nullptr)
+			munmap(mapped, mappedSize);
+		if (fd >= 0)
+			::close(fd);
+		mapped = nullptr;
+		header = nullptr;
+		samples = nullptr;
+		fd = -1;
+	}
+
+	bool isOpen() const { return mapped != nullptr; }
+	int width() const { return header->width; }
+	int height() const { return header->height; }
+	int samplesPerPixel() const { return header->samplesPerPixel; }
+	int maxIter() const { return header->maxIter; }
+	void setMaxIter(const int maxIter) { header->maxIter = maxIter; }
+
+	gSample &at(const int pixelIndex, const int sample) { return samples[(size_t)pixelIndex * header->samplesPerPixel + sample]; }
+	const gSample &at(const int pixelIndex, const int sample) const { return samples[(size_t)pixelIndex * header->samplesPerPixel + sample]; }
+};
+
+// colouring stage: turns every valid sample into a colour and sums them up per pixel
+template <class Colouring>
+void recolor(const gBuffer &gbuf, const Colouring &sampleColor, std::vector<float> &image, std::vector<int> &sampleCount)
+{
+	const int nPixels = gbuf.width() * gbuf.height();
+	image.assign(3 * nPixels, 0.f);
+	sampleCount.assign(nPixels, 0);
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for (int pixelIndex = 0; pixelIndex < nPixels; pixelIndex++)
+	{
+		for (int sample = 0; sample < gbuf.samplesPerPixel(); sample++)
+		{
+			const gSample &s = gbuf.at(pixelIndex, sample);
+			if (!s.valid())
+				continue;
+			const color c = sampleColor(s);
+			image[3*pixelIndex    ] += c.r;
+			image[3*pixelIndex + 1] += c.g;
+			image[3*pixelIndex + 2] += c.b;
+			sampleCount[pixelIndex]++;
+		}
+	}
+}
+
+// sample that hit maxIter, with everything needed to continue its orbit
+struct cappedSample
+{
+	int32_t pixelIndex;
+	int32_t sample;
+	complex z0; // sample coordinate
+	complex z; // value after maxIter iterations
+};
+
+inline std::string cappedSamplesPath(const std::string &gBufferPath) { return gBufferPath + ".capped"; }
+
+// append only sidecar file, tiles hand over their capped samples as a whole
+class cappedSampleWriter
+{
+private:
+	std::ofstream ofs;
+	std::mutex mutex;
+public:
+	bool open(const std::string &path)
+	{
+		ofs.open(path, std::ios::binary | std::ios::trunc);
+		return ofs.is_open();
+	}
+	bool isOpen() const { return ofs.is_open(); }
+	void append(const std::vector<cappedSample> &capped)
+	{
+		if (capped.empty())
+			return;
+		std::lock_guard<std::mutex> lock(mutex);
+		ofs.write((const char*)capped.data(), sizeof(cappedSample) * capped.size());
+	}
+	bool close()
+	{
+		ofs.close();
+		return !ofs.fail();
+	}
+};
+
+// continues all capped samples of a G-buffer up to maxIter, the ones that still
+// do not escape go to a new sidecar file; returns the number of continued
+// samples or -1 if the files could not be read or written
+inline long long continueCappedSamples(gBuffer &gbuf, const std::string &gBufferPath, abstractBaseFractal &fractal,
+	const resumeKernel resume, const int maxIter)
+{
+	const int iterFrom = gbuf.maxIter();
+	if (maxIter <= iterFrom)
+		return 0;
+	const std::string path = cappedSamplesPath(gBufferPath);
+	const std::string nextPath = path + ".next";
+	std::ifstream ifs(path, std::ios::binary);
+	cappedSampleWriter stillCapped;
+	if (!ifs.is_open() || !stillCapped.open(nextPath))
+		return -1;
+	const int chunkSize = 1 << 16;
+	std::vector<cappedSample> capped(chunkSize);
+	long long total = 0;
+	while (ifs)
+	{
+		ifs.read((char*)capped.data(), sizeof(cappedSample) * chunkSize);
+		const int n = ifs.gcount() / sizeof(cappedSample);
+		#pragma omp parallel
+		{
+			const int batchSize = 1024;
+			std::vector<complex> z0(batchSize), zFrom(batchSize);
+			std::vector<orbitResult> results(batchSize);
+			std::vector<cappedSample> next;
+			#pragma omp for schedule(dynamic, 1)
+			for (int first = 0; first < n; first += batchSize)
+			{
+				const int count = std::min(batchSize, n - first);
+				for (int ii = 0; ii < count; ii++)
+				{
+					z0[ii] = capped[first + ii].z0;
+					zFrom[ii] = capped[first + ii].z;
+				}
+				resume(fractal, z0.data(), zFrom.data(), iterFrom, results.data(), count);
+				for (int ii = 0; ii < count; ii++)
+				{
+					cappedSample &s = capped[first + ii];
+					gbuf.at(s.pixelIndex, s.sample) = gSample::fromResult(results[ii]);
+					if (!results[ii].bailedOut && !results[ii].inside)
+						next.push_back({s.pixelIndex, s.sample, s.z0, results[ii].z});
+				}
+			}
+			stillCapped.append(next);
+		}
+		total += n;
+	}
+	ifs.close();
+	if (!stillCapped.close() || std::rename(nextPath.c_str(), path.c_str()) != 0)
+		return -1;
+	gbuf.setMaxIter(maxIter);
+	return total;
+}
@@ -1,47 +1,160 @@
 #pragma once
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
 #include <vector>
 
 
 #include "cubic_spline.h"
+#include "FastMath.h" // fastMathBatch
 
 
 using std::cout;
 using real = double;
 
 
+/* Gradients
+
+   A gradient is given by colour stops at integer indices in [0, length) and
+   is cyclic, colours between the stops come from a cubic Hermite spline
+   (cubic_spline.h). fill() bakes the spline once into a lookup table of
+   2^lut_bits entries (by default at least four per stop). get_color() then
+   indexes the table directly with the scaled position and interpolates
+   linearly between neighbouring entries, the table carries a copy of its
+   first entry at the end so that this needs no wrap around. Channels are
+   stored in separate arrays so that the batch lookup get_colors()
+   vectorizes into gathers. Positions are taken modulo 1 and must be below
+   2^31 in magnitude.
+
+   Where the position changes by a large part of the gradient from one
+   pixel to the next, point samples alias and only many passes average the
+   moire away. The table is therefore followed by a mip chain like a 1-D
+   texture: each level halves the previous one with a [1 2 1] / 4 tent, so
+   that entry j of every level stays centered on position j / size, down to
+   a single entry holding the average colour. get_color() with a footprint
+   (the range of positions a sample stands for, in gradient periods) picks
+   the level whose entries are about that wide and blends the two nearest
+   levels. */
+
 class Gradient
 {
 private:
 	int length;
 	std::vector<color> colors;
 	std::vector<int> indices;
-	int fine_length = 500;
-	std::vector<color> fine_colors;
-	std::vector<int> fine_indices;
-public:
-	Gradient() {
-		length = 40;
-		colors = {color(0,0,0), color(1, 0,0), color(1,1,1), color(0.5f,0.5f,0.9f)};
-		indices = {0, 10, 20, 30};
-		fill();
+	int lut_bits;
+	int lut_size;
+	std::vector<float> lut_r, lut_g, lut_b;
+
+	// smallest table with at least four entries per stop
+	static int default_lut_bits(const int length_)
+	{
+		int bits = 8;
+		while ((1 << bits) < 4 * length_ && bits < 16)
+			bits++;
+		return bits;
+	}
+	// position of xidx (taken modulo 1) in the table, entry index and weight
+	// of the next entry; no floor() or branches, so that batches vectorize
+	void lut_position(const float xidx, const int size, int &index, float &fraction) const
+	{
+		const float t = xidx - (float)(int)xidx;
+		const float pos = (t + (float)(t < 0.f)) * (float)size;
+		// xidx just below an integer may round up to the end of the table
+		const int ii = (int)pos;
+		index = (ii < size - 1) ? ii : size - 1;
+		fraction = pos - (float)index;
 	}
-	Gradient(int length_, std::vector<color> colors_, std::vector<int> indices_) {
+	// start of mip level, 2^(lut_bits - level) entries and the wrap around copy
+	int level_offset(const int level) const { return 2*lut_size - 2*(lut_size >> level) + level; }
+	// fills the levels after the table
+	void build_mips()
+	{
+		for (std::vector<float> *channel : {&lut_r, &lut_g, &lut_b})
+		{
+			channel->resize(level_offset(lut_bits) + 2);
+			for (int level = 1; level <= lut_bits; level++)
+			{
+				const float *previous = channel->data() + level_offset(level - 1);
+				float *current = channel->data() + level_offset(level);
+				const int size = lut_size >> level;
+				for (int jj = 0; jj < size; jj++)
+				{
+					const int before = (jj > 0) ? 2*jj - 1 : 2*size - 1;
+					current[jj] = 0.25f * previous[before] + 0.5f * previous[2*jj] + 0.25f * previous[2*jj + 1];
+				}
+				current[size] = current[0];
+			}
+		}
+	}
+	// interpolated colour of mip level
+	color level_color(const float xidx, const int level) const
+	{
+		int ii;
+		float f;
+		lut_position(xidx, lut_size >> level, ii, f);
+		ii += level_offset(level);
+		return color(
+			lut_r[ii] + f * (lut_r[ii + 1] - lut_r[ii]),
+			lut_g[ii] + f * (lut_g[ii + 1] - lut_g[ii]),
+			lut_b[ii] + f * (lut_b[ii + 1] - lut_b[ii]));
+	}
+	// mip level (with fraction) for footprint, log2 is taken piecewise linearly
+	// between powers of two, which is plenty for picking levels
+	float level_of_detail(const float footprint) const
+	{
+		const float x = footprint * (float)lut_size;
+		int32_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		const int32_t mantissaBits = (bits & 0x007fffff) | 0x3f800000;
+		float mantissa;
+		std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+		const float lod = (float)((bits >> 23) - 127) + mantissa - 1.f;
+		return std::min((float)lut_bits, std::max(0.f, lod));
+	}
+public:
+	Gradient() : Gradient(40, {color(0,0,0), color(1, 0,0), color(1,1,1), color(0.5f,0.5f,0.9f)}, {0, 10, 20, 30}) {}
+	// lut_bits = 0 picks the table size from the number of stops
+	Gradient(int length_, std::vector<color> colors_, std::vector<int> indices_, int lut_bits_ = 0) {
 		length = length_;
 		colors = colors_;
 		indices = indices_;
+		lut_bits = (lut_bits_ > 0) ? lut_bits_ : default_lut_bits(length_);
 		fill();
 	}
+	// from a table baked earlier (r, g, b hold 2^lut_bits_ + 1 entries each,
+	// see table()), without the stops
+	Gradient(int length_, int lut_bits_, const float *r, const float *g, const float *b) {
+		length = length_;
+		lut_bits = lut_bits_;
+		lut_size = 1 << lut_bits;
+		lut_r.assign(r, r + lut_size + 1);
+		lut_g.assign(g, g + lut_size + 1);
+		lut_b.assign(b, b + lut_size + 1);
+		build_mips();
+	}
 	void fill()
 	{
-		fine_indices.resize(500);
-		fine_colors.resize(500);
-		for (int ii = 0; ii < 500; ii++)
-		{
-			fine_indices[ii] = ii;
-			fine_colors[ii] = get_color_cubic((float)ii / 500);
-		}
+		lut_size = 1 << lut_bits;
+		lut_r.resize(lut_size + 1);
+		lut_g.resize(lut_size + 1);
+		lut_b.resize(lut_size + 1);
+		const CubicSpline spline(length, indices, colors);
+		spline.sample(lut_size, lut_r.data(), lut_g.data(), lut_b.data());
+		lut_r[lut_size] = lut_r[0];
+		lut_g[lut_size] = lut_g[0];
+		lut_b[lut_size] = lut_b[0];
+		build_mips();
+	}
+	int get_length() const { return length; }
+	int table_bits() const { return lut_bits; }
+	// baked table of channel 0, 1 or 2 (r, g, b), 2^table_bits() + 1 entries
+	// (the mip levels follow)
+	const float *table(const int channel) const
+	{
+		return (channel == 0) ? lut_r.data() : (channel == 1) ? lut_g.data() : lut_b.data();
 	}
 	void print()
 	{
@@ -57,14 +170,10 @@ public:
 	}
 	void print_fine()
 	{
-		cout << "Printing gradient indices and colors:\n";
+		cout << "Printing gradient lookup table:\n";
 		cout << "=====================================\n";
-		unsigned int ii = 0;
-		for (int idx : fine_indices)
-		{
-			cout << idx << ": (" << fine_colors[ii].r << ", " << fine_colors[ii].g << ", " << fine_colors[ii].b << ")\n";
-			ii++;
-		}
+		for (int ii = 0; ii < lut_size; ii++)
+			cout << ii << ": (" << lut_r[ii] << ", " << lut_g[ii] << ", " << lut_b[ii] << ")\n";
 		cout << "=====================================\n";
 	}
 
@@ -83,1146 +192,1117 @@ public:
 		return gradient_picture;
 	}
 
-	color get_color(float xidx)
+	color get_color(const float xidx) const { return level_color(xidx, 0); }
+	// averaged over footprint (in gradient periods) around xidx
+	color get_color(const float xidx, const float footprint) const
 	{
-		//cout << "Getting color\n";
-		unsigned int search_index = 0;
-		int lower_idx = 0;
-		int higher_idx = 0;
-		color lower_col, higher_col;
-		if (xidx > 1 || xidx < 0) {
-			xidx = xidx - floor(xidx);
-		}
-		float xidx_scaled = (float)this->fine_length * xidx;
-		if (xidx_scaled < (float)fine_indices[0])
-		{
-			lower_idx = fine_indices.back() - length;
-			lower_col = fine_colors.back();
-			higher_idx = fine_indices[0];
-			higher_col = fine_colors[0];
-		}
-		else if (xidx_scaled > (float)fine_indices.back())
-		{
-			lower_idx = fine_indices.back();
-			lower_col = fine_colors.back();
-			higher_idx = fine_indices[0] + length;
-			higher_col = fine_colors[0];
-		}
-		else
-		{
-			for (int idx : fine_indices)
-			{
-
-				if (xidx_scaled == (float)idx)
-				{
-					//cout << "Perfect hit, xidx_scaled: " << xidx_scaled << ", idx: " << idx << "\n";
-					return fine_colors[search_index];
-				}
-				else if ((float)idx > xidx_scaled)
-				{
-					lower_idx = fine_indices[search_index - 1];
-					lower_col = fine_colors[search_index - 1];
-					higher_idx = fine_indices[search_index];
-					higher_col = fine_colors[search_index];
-					break;
-				}
-				search_index++;
-			}
-
-		}
-		//cout << "Linear fine indices: " << fine_indices[search_index - 1] << " " << fine_indices[search_index - 1] << "\n";
-		float idx_fac = (xidx_scaled - (float)lower_idx) / ((float)higher_idx - (float)lower_idx);
-		return color(
-			lower_col.r + idx_fac * (higher_col.r - lower_col.r),
-			lower_col.g + idx_fac * (higher_col.g - lower_col.g),
-			lower_col.b + idx_fac * (higher_col.b - lower_col.b));
+		const float lod = level_of_detail(footprint);
+		const int level = (int)lod;
+		const float w = lod - (float)level;
+		const color fine = level_color(xidx, level);
+		const color coarse = level_color(xidx, (level < lut_bits) ? level + 1 : lut_bits);
+		return fine * (1.f - w) + coarse * w;
 	}
-
-	// ONLY USED FOR INTIAL FILL
-	color get_color_cubic(float xidx) const
+	// without interpolation, for tables fine enough that it does not show
+	color get_color_nearest(const float xidx) const
 	{
-		int n_entries = indices.size();
-		unsigned int search_index = 0;
-		int next_index;
-		xidx = (xidx > 1 || xidx < 0) ? xidx - floor(xidx) : xidx;
-		float xidx_scaled = (float)this->length * xidx;
-		// TODO: add special case for 1 and 2 index gradients? This SHOULD not be necessary though
-		if (xidx_scaled < (float)indices[0] || xidx_scaled >(float)indices.back())
-		{
-			// if color demanded is between the last and first index
-			next_index = 0;
-		}
-		else
+		int ii;
+		float f;
+		lut_position(xidx, lut_size, ii, f);
+		ii += (f >= 0.5f) ? 1 : 0;
+		return color(lut_r[ii], lut_g[ii], lut_b[ii]);
+	}
+	// get_color of n positions at once
+	void get_colors(const float *xidx, color *result, const int n) const
+	{
+		const float *r = lut_r.data();
+		const float *g = lut_g.data();
+		const float *b = lut_b.data();
+		fastMathBatch(n, [=](const int kk)
 		{
-			for (int idx : indices)
-			{
-				if (xidx_scaled == (float)idx)
-				{
-					// skip interpolation if index is hit exactly
-					return colors[search_index];
-				}
-				else if ((float)idx > xidx_scaled)
-				{
-					next_index = search_index;
-					break;
-				}
-				search_index++;
-			}
-
-		}
-		//cout << "Received request for " << xidx << " (scaled to " << xidx_scaled << ")\n";
-		//cout << "Search Index: " << search_index << ", n_entries is " << n_entries << "\n";
-		//cout << "This is between " << indices[search_index] << " and " << indices[search_index] << "\n";
-		std::vector<float> spline_indices(4, 0);
-		std::vector<color> spline_colors(4, 0);
-		for (int jj = 0; jj < 4; jj++)
-		{ 
-			int fetch_index = search_index - 2 + jj;
-			fetch_index = (fetch_index < 0) ? fetch_index + n_entries : fetch_index;
-			//int fetch_index = (search_index - 2 + jj < 0) ? search_index - 2 + jj + n_entries : search_index - 2 + jj;
-			//cout << "Getting point " << jj << " at " << fetch_index << "(" << indices[fetch_index] << ")\n";
-			spline_indices[jj] = (float)indices[fetch_index % n_entries];
-			spline_colors[jj] = colors[fetch_index % n_entries];
-			if (jj > 0) // make sure to cycle if the 4 indices contain the end and beginning
-				spline_indices[jj] = (spline_indices[jj - 1] > spline_indices[jj]) ? spline_indices[jj] + this->length : spline_indices[jj];
-		}
-		// cout << "The 4 spline A indices are: " << spline_indices[0] << " " << spline_indices[1] << " " << spline_indices[2] << " " << spline_indices[3] << "\n";
-		// do a check to make sure that xidx_scaled is between the 2nd and 3rd indices:
-		if (spline_indices[1] > xidx_scaled)
-			for (auto& element : spline_indices) { element -= this->length; }
-		// cout << "The 4 spline B indices are: " << spline_indices[0] << " " << spline_indices[1] << " " << spline_indices[2] << " " << spline_indices[3] << "\n";
-		return splined_color(spline_indices, spline_colors, xidx_scaled);
+			int ii;
+			float f;
+			lut_position(xidx[kk], lut_size, ii, f);
+			result[kk].r = r[ii] + f * (r[ii + 1] - r[ii]);
+			result[kk].g = g[ii] + f * (g[ii + 1] - g[ii]);
+			result[kk].b = b[ii] + f * (b[ii + 1] - b[ii]);
+		});
+	}
+	// get_color with footprints of n positions at once
+	void get_colors(const float *xidx, const float *footprint, color *result, const int n) const
+	{
+		fastMathBatch(n, [=](const int kk) { result[kk] = get_color(xidx[kk], footprint[kk]); });
 	}
 };
 
-// TODO: move this somewhere else
-// define gradients
-float col_div = 1.f/256.f;
+// gradient library, every gradient is built (and its table baked) on first
+// use, so that startup does not pay for the ones a render does not need
+constexpr float col_div = 1.f/256.f;
 
 //CBR_coldhot:
-int CBR_oldhot_length = 11;
-std::vector <int> CBR_coldhot_indices{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-std::vector<color> CBR_coldhot_colors{
-	color(  5*col_div,   48*col_div,   97*col_div),
-	color( 33*col_div,  102*col_div,  172*col_div),
-	color( 67*col_div,  147*col_div,  195*col_div),
-	color(146*col_div,  197*col_div,  222*col_div),
-	color(209*col_div,  229*col_div,  240*col_div),
-	color(247*col_div,  247*col_div,  247*col_div),
-	color(254*col_div,  219*col_div,  199*col_div),
-	color(244*col_div,  165*col_div,  130*col_div),
-	color(214*col_div,   96*col_div,   77*col_div),
-	color(178*col_div,   24*col_div,   43*col_div),
-	color(103*col_div,    0*col_div,   31*col_div)};
-Gradient CBR_coldhot(CBR_oldhot_length, CBR_coldhot_colors, CBR_coldhot_indices);
+const Gradient &CBR_coldhot()
+{
+	static const Gradient gradient(
+		11,
+		{
+			color(  5*col_div,   48*col_div,   97*col_div),
+			color( 33*col_div,  102*col_div,  172*col_div),
+			color( 67*col_div,  147*col_div,  195*col_div),
+			color(146*col_div,  197*col_div,  222*col_div),
+			color(209*col_div,  229*col_div,  240*col_div),
+			color(247*col_div,  247*col_div,  247*col_div),
+			color(254*col_div,  219*col_div,  199*col_div),
+			color(244*col_div,  165*col_div,  130*col_div),
+			color(214*col_div,   96*col_div,   77*col_div),
+			color(178*col_div,   24*col_div,   43*col_div),
+			color(103*col_div,    0*col_div,   31*col_div)
+		},
+		{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}
+	);
+	return gradient;
+}
 
 //jet:
-int jet_length = 63;
-std::vector<int> jet_indices{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
-	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
-	35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
-	54, 55, 56, 57, 58, 59, 60, 61, 62};
-std::vector<color> jet_colors{
-	color(  0*col_div,   0*col_div, 143*col_div),
-	color(  0*col_div,   0*col_div, 159*col_div),
-	color(  0*col_div,   0*col_div, 175*col_div),
-	color(  0*col_div,   0*col_div, 191*col_div),
-	color(  0*col_div,   0*col_div, 207*col_div),
-	color(  0*col_div,   0*col_div, 223*col_div),
-	color(  0*col_div,   0*col_div, 239*col_div),
-	color(  0*col_div,   0*col_div, 255*col_div),
-	color(  0*col_div,  15*col_div, 255*col_div),
-	color(  0*col_div,  31*col_div, 255*col_div),
-	color(  0*col_div,  47*col_div, 255*col_div),
-	color(  0*col_div,  63*col_div, 255*col_div),
-	color(  0*col_div,  79*col_div, 255*col_div),
-	color(  0*col_div,  95*col_div, 255*col_div),
-	color(  0*col_div, 111*col_div, 255*col_div),
-	color(  0*col_div, 127*col_div, 255*col_div),
-	color(  0*col_div, 143*col_div, 255*col_div),
-	color(  0*col_div, 159*col_div, 255*col_div),
-	color(  0*col_div, 175*col_div, 255*col_div),
-	color(  0*col_div, 191*col_div, 255*col_div),
-	color(  0*col_div, 207*col_div, 255*col_div),
-	color(  0*col_div, 223*col_div, 255*col_div),
-	color(  0*col_div, 239*col_div, 255*col_div),
-	color(  0*col_div, 255*col_div, 255*col_div),
-	color( 15*col_div, 255*col_div, 239*col_div),
-	color( 31*col_div, 255*col_div, 223*col_div),
-	color( 47*col_div, 255*col_div, 207*col_div),
-	color( 63*col_div, 255*col_div, 191*col_div),
-	color( 79*col_div, 255*col_div, 175*col_div),
-	color( 95*col_div, 255*col_div, 159*col_div),
-	color(111*col_div, 255*col_div, 143*col_div),
-	color(127*col_div, 255*col_div, 127*col_div),
-	color(143*col_div, 255*col_div, 111*col_div),
-	color(159*col_div, 255*col_div,  95*col_div),
-	color(175*col_div, 255*col_div,  79*col_div),
-	color(191*col_div, 255*col_div,  63*col_div),
-	color(207*col_div, 255*col_div,  47*col_div),
-	color(223*col_div, 255*col_div,  31*col_div),
-	color(239*col_div, 255*col_div,  15*col_div),
-	color(255*col_div, 255*col_div,   0*col_div),
-	color(255*col_div, 239*col_div,   0*col_div),
-	color(255*col_div, 223*col_div,   0*col_div),
-	color(255*col_div, 207*col_div,   0*col_div),
-	color(255*col_div, 191*col_div,   0*col_div),
-	color(255*col_div, 175*col_div,   0*col_div),
-	color(255*col_div, 159*col_div,   0*col_div),
-	color(255*col_div, 143*col_div,   0*col_div),
-	color(255*col_div, 127*col_div,   0*col_div),
-	color(255*col_div, 111*col_div,   0*col_div),
-	color(255*col_div,  95*col_div,   0*col_div),
-	color(255*col_div,  79*col_div,   0*col_div),
-	color(255*col_div,  63*col_div,   0*col_div),
-	color(255*col_div,  47*col_div,   0*col_div),
-	color(255*col_div,  31*col_div,   0*col_div),
-	color(255*col_div,  15*col_div,   0*col_div),
-	color(255*col_div,   0*col_div,   0*col_div),
-	color(239*col_div,   0*col_div,   0*col_div),
-	color(223*col_div,   0*col_div,   0*col_div),
-	color(207*col_div,   0*col_div,   0*col_div),
-	color(191*col_div,   0*col_div,   0*col_div),
-	color(175*col_div,   0*col_div,   0*col_div),
-	color(159*col_div,   0*col_div,   0*col_div),
-	color(143*col_div,   0*col_div,   0*col_div),
-	color(127*col_div,   0*col_div,   0*col_div)};
-Gradient jet(jet_length, jet_colors, jet_indices);
+const Gradient &jet()
+{
+	static const Gradient gradient(
+		63,
+		{
+			color(  0*col_div,   0*col_div, 143*col_div),
+			color(  0*col_div,   0*col_div, 159*col_div),
+			color(  0*col_div,   0*col_div, 175*col_div),
+			color(  0*col_div,   0*col_div, 191*col_div),
+			color(  0*col_div,   0*col_div, 207*col_div),
+			color(  0*col_div,   0*col_div, 223*col_div),
+			color(  0*col_div,   0*col_div, 239*col_div),
+			color(  0*col_div,   0*col_div, 255*col_div),
+			color(  0*col_div,  15*col_div, 255*col_div),
+			color(  0*col_div,  31*col_div, 255*col_div),
+			color(  0*col_div,  47*col_div, 255*col_div),
+			color(  0*col_div,  63*col_div, 255*col_div),
+			color(  0*col_div,  79*col_div, 255*col_div),
+			color(  0*col_div,  95*col_div, 255*col_div),
+			color(  0*col_div, 111*col_div, 255*col_div),
+			color(  0*col_div, 127*col_div, 255*col_div),
+			color(  0*col_div, 143*col_div, 255*col_div),
+			color(  0*col_div, 159*col_div, 255*col_div),
+			color(  0*col_div, 175*col_div, 255*col_div),
+			color(  0*col_div, 191*col_div, 255*col_div),
+			color(  0*col_div, 207*col_div, 255*col_div),
+			color(  0*col_div, 223*col_div, 255*col_div),
+			color(  0*col_div, 239*col_div, 255*col_div),
+			color(  0*col_div, 255*col_div, 255*col_div),
+			color( 15*col_div, 255*col_div, 239*col_div),
+			color( 31*col_div, 255*col_div, 223*col_div),
+			color( 47*col_div, 255*col_div, 207*col_div),
+			color( 63*col_div, 255*col_div, 191*col_div),
+			color( 79*col_div, 255*col_div, 175*col_div),
+			color( 95*col_div, 255*col_div, 159*col_div),
+			color(111*col_div, 255*col_div, 143*col_div),
+			color(127*col_div, 255*col_div, 127*col_div),
+			color(143*col_div, 255*col_div, 111*col_div),
+			color(159*col_div, 255*col_div,  95*col_div),
+			color(175*col_div, 255*col_div,  79*col_div),
+			color(191*col_div, 255*col_div,  63*col_div),
+			color(207*col_div, 255*col_div,  47*col_div),
+			color(223*col_div, 255*col_div,  31*col_div),
+			color(239*col_div, 255*col_div,  15*col_div),
+			color(255*col_div, 255*col_div,   0*col_div),
+			color(255*col_div, 239*col_div,   0*col_div),
+			color(255*col_div, 223*col_div,   0*col_div),
+			color(255*col_div, 207*col_div,   0*col_div),
+			color(255*col_div, 191*col_div,   0*col_div),
+			color(255*col_div, 175*col_div,   0*col_div),
+			color(255*col_div, 159*col_div,   0*col_div),
+			color(255*col_div, 143*col_div,   0*col_div),
+			color(255*col_div, 127*col_div,   0*col_div),
+			color(255*col_div, 111*col_div,   0*col_div),
+			color(255*col_div,  95*col_div,   0*col_div),
+			color(255*col_div,  79*col_div,   0*col_div),
+			color(255*col_div,  63*col_div,   0*col_div),
+			color(255*col_div,  47*col_div,   0*col_div),
+			color(255*col_div,  31*col_div,   0*col_div),
+			color(255*col_div,  15*col_div,   0*col_div),
+			color(255*col_div,   0*col_div,   0*col_div),
+			color(239*col_div,   0*col_div,   0*col_div),
+			color(223*col_div,   0*col_div,   0*col_div),
+			color(207*col_div,   0*col_div,   0*col_div),
+			color(191*col_div,   0*col_div,   0*col_div),
+			color(175*col_div,   0*col_div,   0*col_div),
+			color(159*col_div,   0*col_div,   0*col_div),
+			color(143*col_div,   0*col_div,   0*col_div),
+			color(127*col_div,   0*col_div,   0*col_div)
+		},
+		{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,
+		35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53,
+		54, 55, 56, 57, 58, 59, 60, 61, 62}
+	);
+	return gradient;
+}
 
-Gradient standard_muted(
-	400,
-	{
-		color(0,            0,           0),
-		color(49 / 255.f, 111 / 255.f, 185 / 255.f),
-		color(237 / 256.f,           1,           1),
-		color(246 / 255.f, 220 / 255.f, 116 / 255.f)
-	},
-	{ 0, 84, 198, 270 }
-);
+const Gradient &standard_muted()
+{
+	static const Gradient gradient(
+		400,
+		{
+			color(0,            0,           0),
+			color(49 / 255.f, 111 / 255.f, 185 / 255.f),
+			color(237 / 256.f,           1,           1),
+			color(246 / 255.f, 220 / 255.f, 116 / 255.f)
+		},
+		{ 0, 84, 198, 270 }
+	);
+	return gradient;
+}
 
-Gradient volcano_under_a_glacier(
-	512,
-	{
-		color(0.929412f, 1.000000f, 1.000000f),
-		color(0.920240f, 0.999585f, 0.999821f),
-		color(0.910161f, 0.998360f, 0.999290f),
-		color(0.899225f, 0.996359f, 0.998417f),
-		color(0.887480f, 0.993615f, 0.997213f),
-		color(0.874974f, 0.990160f, 0.995686f),
-		color(0.861756f, 0.986028f, 0.993848f),
-		color(0.847874f, 0.981250f, 0.991708f),
-		color(0.833378f, 0.975861f, 0.989276f),
-		color(0.818315f, 0.969892f, 0.986561f),
-		color(0.802735f, 0.963376f, 0.983575f),
-		color(0.786685f, 0.956347f, 0.980327f),
-		color(0.770215f, 0.948838f, 0.976826f),
-		color(0.753373f, 0.940880f, 0.973083f),
-		color(0.736208f, 0.932507f, 0.969108f),
-		color(0.718768f, 0.923751f, 0.964910f),
-		color(0.701102f, 0.914646f, 0.960501f),
-		color(0.683258f, 0.905224f, 0.955888f),
-		color(0.665286f, 0.895519f, 0.951084f),
-		color(0.647233f, 0.885562f, 0.946097f),
-		color(0.629148f, 0.875387f, 0.940937f),
-		color(0.611080f, 0.865026f, 0.935615f),
-		color(0.593077f, 0.854513f, 0.930140f),
-		color(0.575188f, 0.843880f, 0.924522f),
-		color(0.557462f, 0.833161f, 0.918772f),
-		color(0.539946f, 0.822386f, 0.912899f),
-		color(0.522691f, 0.811591f, 0.906913f),
-		color(0.505744f, 0.800807f, 0.900824f),
-		color(0.489153f, 0.790068f, 0.894643f),
-		color(0.472968f, 0.779405f, 0.888378f),
-		color(0.457237f, 0.768853f, 0.882041f),
-		color(0.442009f, 0.758443f, 0.875640f),
-		color(0.427332f, 0.748209f, 0.869187f),
-		color(0.413255f, 0.738183f, 0.862690f),
-		color(0.399826f, 0.728398f, 0.856160f),
-		color(0.387094f, 0.718888f, 0.849607f),
-		color(0.375108f, 0.709684f, 0.843041f),
-		color(0.363916f, 0.700820f, 0.836471f),
-		color(0.353567f, 0.692329f, 0.829908f),
-		color(0.344109f, 0.684243f, 0.823361f),
-		color(0.335591f, 0.676595f, 0.816842f),
-		color(0.328061f, 0.669418f, 0.810358f),
-		color(0.321569f, 0.662745f, 0.803922f),
-		color(0.315641f, 0.656295f, 0.797439f),
-		color(0.309774f, 0.649766f, 0.790813f),
-		color(0.303967f, 0.643160f, 0.784049f),
-		color(0.298221f, 0.636481f, 0.777149f),
-		color(0.292534f, 0.629731f, 0.770116f),
-		color(0.286907f, 0.622911f, 0.762956f),
-		color(0.281340f, 0.616025f, 0.755670f),
-		color(0.275833f, 0.609075f, 0.748263f),
-		color(0.270385f, 0.602063f, 0.740738f),
-		color(0.264996f, 0.594991f, 0.733099f),
-		color(0.259666f, 0.587863f, 0.725350f),
-		color(0.254395f, 0.580680f, 0.717493f),
-		color(0.249183f, 0.573445f, 0.709532f),
-		color(0.244030f, 0.566160f, 0.701472f),
-		color(0.238936f, 0.558827f, 0.693314f),
-		color(0.233899f, 0.551450f, 0.685064f),
-		color(0.228921f, 0.544030f, 0.676725f),
-		color(0.224001f, 0.536571f, 0.668300f),
-		color(0.219139f, 0.529073f, 0.659792f),
-		color(0.214335f, 0.521540f, 0.651206f),
-		color(0.209589f, 0.513975f, 0.642544f),
-		color(0.204900f, 0.506378f, 0.633811f),
-		color(0.200268f, 0.498754f, 0.625010f),
-		color(0.195694f, 0.491104f, 0.616144f),
-		color(0.191176f, 0.483431f, 0.607217f),
-		color(0.186716f, 0.475737f, 0.598233f),
-		color(0.182312f, 0.468025f, 0.589195f),
-		color(0.177965f, 0.460296f, 0.580106f),
-		color(0.173675f, 0.452554f, 0.570971f),
-		color(0.169441f, 0.444801f, 0.561793f),
-		color(0.165263f, 0.437039f, 0.552575f),
-		color(0.161141f, 0.429270f, 0.543320f),
-		color(0.157075f, 0.421498f, 0.534034f),
-		color(0.153065f, 0.413724f, 0.524718f),
-		color(0.149110f, 0.405951f, 0.515376f),
-		color(0.145211f, 0.398181f, 0.506013f),
-		color(0.141367f, 0.390416f, 0.496632f),
-		color(0.137579f, 0.382660f, 0.487235f),
-		color(0.133845f, 0.374914f, 0.477828f),
-		color(0.130167f, 0.367182f, 0.468412f),
-		color(0.126543f, 0.359464f, 0.458993f),
-		color(0.122973f, 0.351764f, 0.449573f),
-		color(0.119459f, 0.344084f, 0.440156f),
-		color(0.115998f, 0.336427f, 0.430745f),
-		color(0.112592f, 0.328795f, 0.421344f),
-		color(0.109239f, 0.321189f, 0.411957f),
-		color(0.105941f, 0.313614f, 0.402588f),
-		color(0.102696f, 0.306071f, 0.393239f),
-		color(0.099505f, 0.298562f, 0.383914f),
-		color(0.096367f, 0.291091f, 0.374617f),
-		color(0.093282f, 0.283658f, 0.365351f),
-		color(0.090251f, 0.276268f, 0.356120f),
-		color(0.087273f, 0.268922f, 0.346928f),
-		color(0.084347f, 0.261622f, 0.337778f),
-		color(0.081474f, 0.254371f, 0.328673f),
-		color(0.078654f, 0.247172f, 0.319618f),
-		color(0.075886f, 0.240026f, 0.310615f),
-		color(0.073171f, 0.232937f, 0.301668f),
-		color(0.070507f, 0.225907f, 0.292781f),
-		color(0.067895f, 0.218937f, 0.283958f),
-		color(0.065336f, 0.212031f, 0.275201f),
-		color(0.062828f, 0.205191f, 0.266515f),
-		color(0.060371f, 0.198419f, 0.257903f),
-		color(0.057966f, 0.191717f, 0.249368f),
-		color(0.055612f, 0.185089f, 0.240914f),
-		color(0.053309f, 0.178536f, 0.232545f),
-		color(0.051058f, 0.172062f, 0.224265f),
-		color(0.048857f, 0.165667f, 0.216076f),
-		color(0.046706f, 0.159355f, 0.207982f),
-		color(0.044606f, 0.153129f, 0.199987f),
-		color(0.042557f, 0.146990f, 0.192095f),
-		color(0.040558f, 0.140941f, 0.184308f),
-		color(0.038608f, 0.134984f, 0.176631f),
-		color(0.036709f, 0.129122f, 0.169067f),
-		color(0.034859f, 0.123357f, 0.161620f),
-		color(0.033060f, 0.117692f, 0.154293f),
-		color(0.031309f, 0.112128f, 0.147090f),
-		color(0.029608f, 0.106670f, 0.140014f),
-		color(0.027956f, 0.101318f, 0.133068f),
-		color(0.026353f, 0.096075f, 0.126257f),
-		color(0.024800f, 0.090944f, 0.119584f),
-		color(0.023294f, 0.085926f, 0.113053f),
-		color(0.021838f, 0.081026f, 0.106666f),
-		color(0.020430f, 0.076244f, 0.100428f),
-		color(0.019070f, 0.071583f, 0.094343f),
-		color(0.017759f, 0.067046f, 0.088413f),
-		color(0.016495f, 0.062635f, 0.082642f),
-		color(0.015279f, 0.058353f, 0.077034f),
-		color(0.014111f, 0.054202f, 0.071592f),
-		color(0.012991f, 0.050183f, 0.066320f),
-		color(0.011918f, 0.046301f, 0.061222f),
-		color(0.010892f, 0.042557f, 0.056300f),
-		color(0.009914f, 0.038953f, 0.051560f),
-		color(0.008983f, 0.035492f, 0.047003f),
-		color(0.008098f, 0.032176f, 0.042634f),
-		color(0.007260f, 0.029008f, 0.038456f),
-		color(0.006469f, 0.025991f, 0.034473f),
-		color(0.005724f, 0.023126f, 0.030688f),
-		color(0.005025f, 0.020416f, 0.027105f),
-		color(0.004373f, 0.017863f, 0.023728f),
-		color(0.003766f, 0.015470f, 0.020559f),
-		color(0.003206f, 0.013239f, 0.017603f),
-		color(0.002691f, 0.011173f, 0.014863f),
-		color(0.002221f, 0.009274f, 0.012343f),
-		color(0.001797f, 0.007545f, 0.010046f),
-		color(0.001419f, 0.005987f, 0.007975f),
-		color(0.001085f, 0.004603f, 0.006135f),
-		color(0.000796f, 0.003397f, 0.004529f),
-		color(0.000552f, 0.002369f, 0.003160f),
-		color(0.000353f, 0.001522f, 0.002032f),
-		color(0.000198f, 0.000860f, 0.001148f),
-		color(0.000088f, 0.000384f, 0.000513f),
-		color(0.000022f, 0.000096f, 0.000129f),
-		color(0.000000f, 0.000000f, 0.000000f),
-		color(0.000455f, 0.000043f, 0.000059f),
-		color(0.001795f, 0.000168f, 0.000231f),
-		color(0.003978f, 0.000373f, 0.000512f),
-		color(0.006966f, 0.000652f, 0.000895f),
-		color(0.010718f, 0.001003f, 0.001375f),
-		color(0.015195f, 0.001422f, 0.001947f),
-		color(0.020356f, 0.001904f, 0.002604f),
-		color(0.026161f, 0.002446f, 0.003343f),
-		color(0.032571f, 0.003044f, 0.004155f),
-		color(0.039546f, 0.003694f, 0.005037f),
-		color(0.047045f, 0.004392f, 0.005983f),
-		color(0.055030f, 0.005135f, 0.006987f),
-		color(0.063459f, 0.005918f, 0.008044f),
-		color(0.072293f, 0.006738f, 0.009147f),
-		color(0.081492f, 0.007591f, 0.010292f),
-		color(0.091015f, 0.008473f, 0.011473f),
-		color(0.100825f, 0.009380f, 0.012685f),
-		color(0.110879f, 0.010308f, 0.013921f),
-		color(0.121138f, 0.011255f, 0.015176f),
-		color(0.131563f, 0.012214f, 0.016445f),
-		color(0.142114f, 0.013184f, 0.017722f),
-		color(0.152749f, 0.014159f, 0.019002f),
-		color(0.163431f, 0.015137f, 0.020279f),
-		color(0.174118f, 0.016113f, 0.021547f),
-		color(0.184770f, 0.017084f, 0.022801f),
-		color(0.195348f, 0.018045f, 0.024036f),
-		color(0.205813f, 0.018993f, 0.025245f),
-		color(0.216123f, 0.019924f, 0.026424f),
-		color(0.226238f, 0.020834f, 0.027566f),
-		color(0.236120f, 0.021719f, 0.028666f),
-		color(0.245728f, 0.022576f, 0.029719f),
-		color(0.255023f, 0.023401f, 0.030719f),
-		color(0.263963f, 0.024189f, 0.031660f),
-		color(0.272510f, 0.024937f, 0.032537f),
-		color(0.280623f, 0.025641f, 0.033345f),
-		color(0.288262f, 0.026297f, 0.034077f),
-		color(0.295388f, 0.026902f, 0.034729f),
-		color(0.301961f, 0.027451f, 0.035294f),
-		color(0.308230f, 0.027924f, 0.035784f),
-		color(0.314470f, 0.028306f, 0.036213f),
-		color(0.320683f, 0.028601f, 0.036586f),
-		color(0.326867f, 0.028814f, 0.036904f),
-		color(0.333022f, 0.028950f, 0.037170f),
-		color(0.339148f, 0.029013f, 0.037387f),
-		color(0.345244f, 0.029007f, 0.037558f),
-		color(0.351310f, 0.028938f, 0.037686f),
-		color(0.357345f, 0.028810f, 0.037772f),
-		color(0.363350f, 0.028626f, 0.037820f),
-		color(0.369323f, 0.028393f, 0.037833f),
-		color(0.375265f, 0.028115f, 0.037813f),
-		color(0.381174f, 0.027795f, 0.037762f),
-		color(0.387051f, 0.027440f, 0.037684f),
-		color(0.392896f, 0.027052f, 0.037582f),
-		color(0.398707f, 0.026638f, 0.037457f),
-		color(0.404484f, 0.026201f, 0.037312f),
-		color(0.410228f, 0.025745f, 0.037152f),
-		color(0.415937f, 0.025277f, 0.036977f),
-		color(0.421611f, 0.024799f, 0.036790f),
-		color(0.427250f, 0.024318f, 0.036596f),
-		color(0.432854f, 0.023836f, 0.036395f),
-		color(0.438422f, 0.023360f, 0.036191f),
-		color(0.443954f, 0.022893f, 0.035986f),
-		color(0.449448f, 0.022440f, 0.035784f),
-		color(0.454906f, 0.022005f, 0.035586f),
-		color(0.460327f, 0.021594f, 0.035396f),
-		color(0.465709f, 0.021211f, 0.035216f),
-		color(0.471054f, 0.020860f, 0.035049f),
-		color(0.476360f, 0.020545f, 0.034898f),
-		color(0.481626f, 0.020273f, 0.034765f),
-		color(0.486854f, 0.020046f, 0.034653f),
-		color(0.492042f, 0.019870f, 0.034565f),
-		color(0.497189f, 0.019749f, 0.034503f),
-		color(0.502297f, 0.019688f, 0.034470f),
-		color(0.507363f, 0.019692f, 0.034469f),
-		color(0.512388f, 0.019764f, 0.034502f),
-		color(0.517371f, 0.019910f, 0.034573f),
-		color(0.522312f, 0.020134f, 0.034683f),
-		color(0.527211f, 0.020440f, 0.034836f),
-		color(0.532067f, 0.020834f, 0.035035f),
-		color(0.536880f, 0.021320f, 0.035281f),
-		color(0.541649f, 0.021902f, 0.035578f),
-		color(0.546375f, 0.022585f, 0.035928f),
-		color(0.551056f, 0.023374f, 0.036334f),
-		color(0.555692f, 0.024272f, 0.036799f),
-		color(0.560283f, 0.025286f, 0.037325f),
-		color(0.564828f, 0.026419f, 0.037916f),
-		color(0.569328f, 0.027675f, 0.038573f),
-		color(0.573782f, 0.029060f, 0.039299f),
-		color(0.578188f, 0.030578f, 0.040098f),
-		color(0.582548f, 0.032234f, 0.040972f),
-		color(0.586860f, 0.034031f, 0.041923f),
-		color(0.591125f, 0.035976f, 0.042955f),
-		color(0.595341f, 0.038072f, 0.044069f),
-		color(0.599509f, 0.040323f, 0.045269f),
-		color(0.603628f, 0.042736f, 0.046558f),
-		color(0.607697f, 0.045313f, 0.047937f),
-		color(0.611717f, 0.048059f, 0.049411f),
-		color(0.615686f, 0.050980f, 0.050980f),
-		color(0.619647f, 0.054017f, 0.052605f),
-		color(0.623641f, 0.057107f, 0.054240f),
-		color(0.627665f, 0.060250f, 0.055887f),
-		color(0.631719f, 0.063444f, 0.057545f),
-		color(0.635802f, 0.066690f, 0.059214f),
-		color(0.639913f, 0.069985f, 0.060895f),
-		color(0.644049f, 0.073331f, 0.062587f),
-		color(0.648211f, 0.076725f, 0.064290f),
-		color(0.652396f, 0.080167f, 0.066005f),
-		color(0.656604f, 0.083656f, 0.067732f),
-		color(0.660833f, 0.087192f, 0.069470f),
-		color(0.665082f, 0.090773f, 0.071219f),
-		color(0.669350f, 0.094399f, 0.072981f),
-		color(0.673636f, 0.098069f, 0.074754f),
-		color(0.677938f, 0.101783f, 0.076539f),
-		color(0.682255f, 0.105538f, 0.078336f),
-		color(0.686586f, 0.109336f, 0.080145f),
-		color(0.690930f, 0.113175f, 0.081966f),
-		color(0.695285f, 0.117053f, 0.083798f),
-		color(0.699651f, 0.120971f, 0.085643f),
-		color(0.704025f, 0.124928f, 0.087500f),
-		color(0.708407f, 0.128922f, 0.089369f),
-		color(0.712796f, 0.132954f, 0.091251f),
-		color(0.717190f, 0.137021f, 0.093144f),
-		color(0.721588f, 0.141124f, 0.095050f),
-		color(0.725990f, 0.145262f, 0.096968f),
-		color(0.730392f, 0.149434f, 0.098899f),
-		color(0.734795f, 0.153638f, 0.100842f),
-		color(0.739198f, 0.157875f, 0.102798f),
-		color(0.743598f, 0.162144f, 0.104766f),
-		color(0.747995f, 0.166444f, 0.106747f),
-		color(0.752387f, 0.170773f, 0.108740f),
-		color(0.756774f, 0.175132f, 0.110746f),
-		color(0.761154f, 0.179519f, 0.112765f),
-		color(0.765525f, 0.183933f, 0.114797f),
-		color(0.769888f, 0.188375f, 0.116842f),
-		color(0.774239f, 0.192842f, 0.118899f),
-		color(0.778579f, 0.197335f, 0.120970f),
-		color(0.782905f, 0.201853f, 0.123053f),
-		color(0.787217f, 0.206394f, 0.125150f),
-		color(0.791514f, 0.210958f, 0.127259f),
-		color(0.795794f, 0.215544f, 0.129382f),
-		color(0.800056f, 0.220152f, 0.131518f),
-		color(0.804298f, 0.224780f, 0.133668f),
-		color(0.808520f, 0.229429f, 0.135831f),
-		color(0.812721f, 0.234096f, 0.138007f),
-		color(0.816898f, 0.238781f, 0.140196f),
-		color(0.821051f, 0.243484f, 0.142399f),
-		color(0.825179f, 0.248204f, 0.144616f),
-		color(0.829281f, 0.252939f, 0.146846f),
-		color(0.833354f, 0.257690f, 0.149089f),
-		color(0.837398f, 0.262455f, 0.151347f),
-		color(0.841412f, 0.267234f, 0.153618f),
-		color(0.845395f, 0.272025f, 0.155903f),
-		color(0.849345f, 0.276829f, 0.158201f),
-		color(0.853260f, 0.281643f, 0.160514f),
-		color(0.857141f, 0.286469f, 0.162840f),
-		color(0.860985f, 0.291303f, 0.165181f),
-		color(0.864791f, 0.296147f, 0.167535f),
-		color(0.868559f, 0.300999f, 0.169904f),
-		color(0.872286f, 0.305858f, 0.172287f),
-		color(0.875972f, 0.310724f, 0.174684f),
-		color(0.879616f, 0.315596f, 0.177095f),
-		color(0.883215f, 0.320472f, 0.179520f),
-		color(0.886770f, 0.325353f, 0.181960f),
-		color(0.890278f, 0.330237f, 0.184414f),
-		color(0.893739f, 0.335124f, 0.186883f),
-		color(0.897151f, 0.340012f, 0.189366f),
-		color(0.900513f, 0.344902f, 0.191863f),
-		color(0.903824f, 0.349792f, 0.194375f),
-		color(0.907083f, 0.354682f, 0.196902f),
-		color(0.910288f, 0.359570f, 0.199444f),
-		color(0.913438f, 0.364456f, 0.202000f),
-		color(0.916532f, 0.369339f, 0.204571f),
-		color(0.919568f, 0.374219f, 0.207157f),
-		color(0.922546f, 0.379095f, 0.209758f),
-		color(0.925464f, 0.383965f, 0.212373f),
-		color(0.928322f, 0.388829f, 0.215004f),
-		color(0.931117f, 0.393687f, 0.217650f),
-		color(0.933848f, 0.398537f, 0.220310f),
-		color(0.936515f, 0.403379f, 0.222986f),
-		color(0.939116f, 0.408211f, 0.225677f),
-		color(0.941649f, 0.413034f, 0.228384f),
-		color(0.944115f, 0.417846f, 0.231105f),
-		color(0.946511f, 0.422647f, 0.233842f),
-		color(0.948835f, 0.427436f, 0.236595f),
-		color(0.951088f, 0.432211f, 0.239363f),
-		color(0.953268f, 0.436973f, 0.242146f),
-		color(0.955373f, 0.441720f, 0.244945f),
-		color(0.957402f, 0.446452f, 0.247759f),
-		color(0.959354f, 0.451168f, 0.250589f),
-		color(0.961228f, 0.455867f, 0.253435f),
-		color(0.963023f, 0.460549f, 0.256297f),
-		color(0.964737f, 0.465212f, 0.259174f),
-		color(0.966369f, 0.469855f, 0.262067f),
-		color(0.967918f, 0.474479f, 0.264976f),
-		color(0.969382f, 0.479082f, 0.267902f),
-		color(0.970761f, 0.483663f, 0.270843f),
-		color(0.972053f, 0.488222f, 0.273800f),
-		color(0.973257f, 0.492758f, 0.276773f),
-		color(0.974372f, 0.497269f, 0.279762f),
-		color(0.975396f, 0.501757f, 0.282768f),
-		color(0.976329f, 0.506218f, 0.285790f),
-		color(0.977169f, 0.510654f, 0.288828f),
-		color(0.977914f, 0.515062f, 0.291882f),
-		color(0.978564f, 0.519443f, 0.294953f),
-		color(0.979118f, 0.523795f, 0.298040f),
-		color(0.979573f, 0.528117f, 0.301144f),
-		color(0.979930f, 0.532410f, 0.304265f),
-		color(0.980186f, 0.536671f, 0.307402f),
-		color(0.980340f, 0.540901f, 0.310555f),
-		color(0.980392f, 0.545098f, 0.313725f),
-		color(0.980390f, 0.549309f, 0.316912f),
-		color(0.980383f, 0.553579f, 0.320115f),
-		color(0.980372f, 0.557907f, 0.323333f),
-		color(0.980356f, 0.562291f, 0.326567f),
-		color(0.980335f, 0.566728f, 0.329816f),
-		color(0.980310f, 0.571219f, 0.333081f),
-		color(0.980281f, 0.575760f, 0.336362f),
-		color(0.980247f, 0.580350f, 0.339659f),
-		color(0.980209f, 0.584988f, 0.342970f),
-		color(0.980167f, 0.589671f, 0.346298f),
-		color(0.980120f, 0.594399f, 0.349640f),
-		color(0.980069f, 0.599169f, 0.352998f),
-		color(0.980013f, 0.603979f, 0.356371f),
-		color(0.979954f, 0.608829f, 0.359760f),
-		color(0.979890f, 0.613715f, 0.363164f),
-		color(0.979822f, 0.618638f, 0.366583f),
-		color(0.979749f, 0.623594f, 0.370017f),
-		color(0.979673f, 0.628582f, 0.373466f),
-		color(0.979593f, 0.633601f, 0.376930f),
-		color(0.979508f, 0.638649f, 0.380409f),
-		color(0.979419f, 0.643724f, 0.383903f),
-		color(0.979327f, 0.648824f, 0.387412f),
-		color(0.979230f, 0.653948f, 0.390936f),
-		color(0.979129f, 0.659094f, 0.394475f),
-		color(0.979025f, 0.664260f, 0.398028f),
-		color(0.978916f, 0.669445f, 0.401596f),
-		color(0.978804f, 0.674647f, 0.405179f),
-		color(0.978688f, 0.679864f, 0.408776f),
-		color(0.978568f, 0.685095f, 0.412388f),
-		color(0.978444f, 0.690338f, 0.416015f),
-		color(0.978316f, 0.695591f, 0.419656f),
-		color(0.978185f, 0.700852f, 0.423311f),
-		color(0.978049f, 0.706120f, 0.426981f),
-		color(0.977910f, 0.711394f, 0.430665f),
-		color(0.977768f, 0.716670f, 0.434363f),
-		color(0.977622f, 0.721949f, 0.438076f),
-		color(0.977472f, 0.727227f, 0.441803f),
-		color(0.977318f, 0.732504f, 0.445544f),
-		color(0.977161f, 0.737778f, 0.449299f),
-		color(0.977001f, 0.743046f, 0.453069f),
-		color(0.976837f, 0.748308f, 0.456852f),
-		color(0.976669f, 0.753561f, 0.460649f),
-		color(0.976498f, 0.758804f, 0.464460f),
-		color(0.976324f, 0.764035f, 0.468286f),
-		color(0.976146f, 0.769253f, 0.472125f),
-		color(0.975965f, 0.774456f, 0.475977f),
-		color(0.975780f, 0.779642f, 0.479844f),
-		color(0.975592f, 0.784809f, 0.483724f),
-		color(0.975401f, 0.789956f, 0.487618f),
-		color(0.975207f, 0.795081f, 0.491525f),
-		color(0.975009f, 0.800182f, 0.495447f),
-		color(0.974808f, 0.805258f, 0.499381f),
-		color(0.974604f, 0.810307f, 0.503329f),
-		color(0.974397f, 0.815327f, 0.507291f),
-		color(0.974186f, 0.820317f, 0.511266f),
-		color(0.973973f, 0.825274f, 0.515254f),
-		color(0.973756f, 0.830198f, 0.519256f),
-		color(0.973537f, 0.835086f, 0.523271f),
-		color(0.973314f, 0.839937f, 0.527299f),
-		color(0.973088f, 0.844749f, 0.531340f),
-		color(0.972860f, 0.849521f, 0.535394f),
-		color(0.972628f, 0.854250f, 0.539462f),
-		color(0.972394f, 0.858936f, 0.543542f),
-		color(0.972157f, 0.863575f, 0.547635f),
-		color(0.971916f, 0.868168f, 0.551742f),
-		color(0.971673f, 0.872711f, 0.555861f),
-		color(0.971428f, 0.877203f, 0.559993f),
-		color(0.971179f, 0.881644f, 0.564138f),
-		color(0.970928f, 0.886029f, 0.568296f),
-		color(0.970673f, 0.890360f, 0.572466f),
-		color(0.970417f, 0.894632f, 0.576649f),
-		color(0.970157f, 0.898846f, 0.580845f),
-		color(0.969895f, 0.902998f, 0.585053f),
-		color(0.969630f, 0.907088f, 0.589274f),
-		color(0.969363f, 0.911114f, 0.593507f),
-		color(0.969093f, 0.915074f, 0.597753f),
-		color(0.968821f, 0.918966f, 0.602011f),
-		color(0.968546f, 0.922788f, 0.606281f),
-		color(0.968269f, 0.926540f, 0.610564f),
-		color(0.967989f, 0.930219f, 0.614859f),
-		color(0.967707f, 0.933823f, 0.619166f),
-		color(0.967422f, 0.937351f, 0.623485f),
-		color(0.967135f, 0.940802f, 0.627817f),
-		color(0.966846f, 0.944173f, 0.632160f),
-		color(0.966554f, 0.947463f, 0.636516f),
-		color(0.966260f, 0.950670f, 0.640883f),
-		color(0.965964f, 0.953792f, 0.645263f),
-		color(0.965665f, 0.956828f, 0.649654f),
-		color(0.965365f, 0.959776f, 0.654057f),
-		color(0.965062f, 0.962634f, 0.658472f),
-		color(0.964757f, 0.965401f, 0.662899f),
-		color(0.964450f, 0.968075f, 0.667338f),
-		color(0.964141f, 0.970654f, 0.671788f),
-		color(0.963829f, 0.973137f, 0.676249f),
-		color(0.963516f, 0.975522f, 0.680723f),
-		color(0.963201f, 0.977807f, 0.685208f),
-		color(0.962883f, 0.979990f, 0.689704f),
-		color(0.962564f, 0.982070f, 0.694212f),
-		color(0.962243f, 0.984045f, 0.698731f),
-		color(0.961920f, 0.985914f, 0.703261f),
-		color(0.961595f, 0.987674f, 0.707803f),
-		color(0.961268f, 0.989324f, 0.712356f),
-		color(0.960939f, 0.990863f, 0.716920f),
-		color(0.960609f, 0.992288f, 0.721496f),
-		color(0.960276f, 0.993598f, 0.726082f),
-		color(0.959943f, 0.994792f, 0.730680f),
-		color(0.959607f, 0.995867f, 0.735289f),
-		color(0.959269f, 0.996822f, 0.739908f),
-		color(0.958930f, 0.997655f, 0.744539f),
-		color(0.958590f, 0.998364f, 0.749180f),
-		color(0.958247f, 0.998949f, 0.753832f),
-		color(0.957904f, 0.999406f, 0.758495f),
-		color(0.957558f, 0.999735f, 0.763169f),
-		color(0.957211f, 0.999933f, 0.767854f),
-		color(0.956863f, 1.000000f, 0.772549f),
-		color(0.956724f, 1.000000f, 0.777646f),
-		color(0.956974f, 1.000000f, 0.783494f),
-		color(0.957569f, 1.000000f, 0.790031f),
-		color(0.958462f, 1.000000f, 0.797195f),
-		color(0.959609f, 1.000000f, 0.804924f),
-		color(0.960963f, 1.000000f, 0.813155f),
-		color(0.962480f, 1.000000f, 0.821825f),
-		color(0.964114f, 1.000000f, 0.830874f),
-		color(0.965820f, 1.000000f, 0.840237f),
-		color(0.967551f, 1.000000f, 0.849854f),
-		color(0.969263f, 1.000000f, 0.859662f),
-		color(0.970910f, 1.000000f, 0.869598f),
-		color(0.972447f, 1.000000f, 0.879601f),
-		color(0.973827f, 1.000000f, 0.889608f),
-		color(0.975007f, 1.000000f, 0.899556f),
-		color(0.975940f, 1.000000f, 0.909384f),
-		color(0.976580f, 1.000000f, 0.919029f),
-		color(0.976883f, 1.000000f, 0.928429f),
-		color(0.976803f, 1.000000f, 0.937522f),
-		color(0.976294f, 1.000000f, 0.946246f),
-		color(0.975312f, 1.000000f, 0.954537f),
-		color(0.973809f, 1.000000f, 0.962334f),
-		color(0.971742f, 1.000000f, 0.969575f),
-		color(0.969065f, 1.000000f, 0.976197f),
-		color(0.965731f, 1.000000f, 0.982139f),
-		color(0.961696f, 1.000000f, 0.987337f),
-		color(0.956915f, 1.000000f, 0.991730f),
-		color(0.951341f, 1.000000f, 0.995254f),
-		color(0.944930f, 1.000000f, 0.997849f),
-		color(0.937635f, 1.000000f, 0.999452f)
-	},
-	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383, 384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399, 400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413, 414, 415, 416, 417, 418, 419, 420, 421, 422, 423, 424, 425, 426, 427, 428, 429, 430, 431, 432, 433, 434, 435, 436, 437, 438, 439, 440, 441, 442, 443, 444, 445, 446, 447, 448, 449, 450, 451, 452, 453, 454, 455, 456, 457, 458, 459, 460, 461, 462, 463, 464, 465, 466, 467, 468, 469, 470, 471, 472, 473, 474, 475, 476, 477, 478, 479, 480, 481, 482, 483, 484, 485, 486, 487, 488, 489, 490, 491, 492, 493, 494, 495, 496, 497, 498, 499, 500, 501, 502, 503, 504, 505, 506, 507, 508, 509, 510, 511 }
-);
+const Gradient &volcano_under_a_glacier()
+{
+	static const Gradient gradient(
+		512,
+		{
+			color(0.929412f, 1.000000f, 1.000000f),
+			color(0.920240f, 0.999585f, 0.999821f),
+			color(0.910161f, 0.998360f, 0.999290f),
+			color(0.899225f, 0.996359f, 0.998417f),
+			color(0.887480f, 0.993615f, 0.997213f),
+			color(0.874974f, 0.990160f, 0.995686f),
+			color(0.861756f, 0.986028f, 0.993848f),
+			color(0.847874f, 0.981250f, 0.991708f),
+			color(0.833378f, 0.975861f, 0.989276f),
+			color(0.818315f, 0.969892f, 0.986561f),
+			color(0.802735f, 0.963376f, 0.983575f),
+			color(0.786685f, 0.956347f, 0.980327f),
+			color(0.770215f, 0.948838f, 0.976826f),
+			color(0.753373f, 0.940880f, 0.973083f),
+			color(0.736208f, 0.932507f, 0.969108f),
+			color(0.718768f, 0.923751f, 0.964910f),
+			color(0.701102f, 0.914646f, 0.960501f),
+			color(0.683258f, 0.905224f, 0.955888f),
+			color(0.665286f, 0.895519f, 0.951084f),
+			color(0.647233f, 0.885562f, 0.946097f),
+			color(0.629148f, 0.875387f, 0.940937f),
+			color(0.611080f, 0.865026f, 0.935615f),
+			color(0.593077f, 0.854513f, 0.930140f),
+			color(0.575188f, 0.843880f, 0.924522f),
+			color(0.557462f, 0.833161f, 0.918772f),
+			color(0.539946f, 0.822386f, 0.912899f),
+			color(0.522691f, 0.811591f, 0.906913f),
+			color(0.505744f, 0.800807f, 0.900824f),
+			color(0.489153f, 0.790068f, 0.894643f),
+			color(0.472968f, 0.779405f, 0.888378f),
+			color(0.457237f, 0.768853f, 0.882041f),
+			color(0.442009f, 0.758443f, 0.875640f),
+			color(0.427332f, 0.748209f, 0.869187f),
+			color(0.413255f, 0.738183f, 0.862690f),
+			color(0.399826f, 0.728398f, 0.856160f),
+			color(0.387094f, 0.718888f, 0.849607f),
+			color(0.375108f, 0.709684f, 0.843041f),
+			color(0.363916f, 0.700820f, 0.836471f),
+			color(0.353567f, 0.692329f, 0.829908f),
+			color(0.344109f, 0.684243f, 0.823361f),
+			color(0.335591f, 0.676595f, 0.816842f),
+			color(0.328061f, 0.669418f, 0.810358f),
+			color(0.321569f, 0.662745f, 0.803922f),
+			color(0.315641f, 0.656295f, 0.797439f),
+			color(0.309774f, 0.649766f, 0.790813f),
+			color(0.303967f, 0.643160f, 0.784049f),
+			color(0.298221f, 0.636481f, 0.777149f),
+			color(0.292534f, 0.629731f, 0.770116f),
+			color(0.286907f, 0.622911f, 0.762956f),
+			color(0.281340f, 0.616025f, 0.755670f),
+			color(0.275833f, 0.609075f, 0.748263f),
+			color(0.270385f, 0.602063f, 0.740738f),
+			color(0.264996f, 0.594991f, 0.733099f),
+			color(0.259666f, 0.587863f, 0.725350f),
+			color(0.254395f, 0.580680f, 0.717493f),
+			color(0.249183f, 0.573445f, 0.709532f),
+			color(0.244030f, 0.566160f, 0.701472f),
+			color(0.238936f, 0.558827f, 0.693314f),
+			color(0.233899f, 0.551450f, 0.685064f),
+			color(0.228921f, 0.544030f, 0.676725f),
+			color(0.224001f, 0.536571f, 0.668300f),
+			color(0.219139f, 0.529073f, 0.659792f),
+			color(0.214335f, 0.521540f, 0.651206f),
+			color(0.209589f, 0.513975f, 0.642544f),
+			color(0.204900f, 0.506378f, 0.633811f),
+			color(0.200268f, 0.498754f, 0.625010f),
+			color(0.195694f, 0.491104f, 0.616144f),
+			color(0.191176f, 0.483431f, 0.607217f),
+			color(0.186716f, 0.475737f, 0.598233f),
+			color(0.182312f, 0.468025f, 0.589195f),
+			color(0.177965f, 0.460296f, 0.580106f),
+			color(0.173675f, 0.452554f, 0.570971f),
+			color(0.169441f, 0.444801f, 0.561793f),
+			color(0.165263f, 0.437039f, 0.552575f),
+			color(0.161141f, 0.429270f, 0.543320f),
+			color(0.157075f, 0.421498f, 0.534034f),
+			color(0.153065f, 0.413724f, 0.524718f),
+			color(0.149110f, 0.405951f, 0.515376f),
+			color(0.145211f, 0.398181f, 0.506013f),
+			color(0.141367f, 0.390416f, 0.496632f),
+			color(0.137579f, 0.382660f, 0.487235f),
+			color(0.133845f, 0.374914f, 0.477828f),
+			color(0.130167f, 0.367182f, 0.468412f),
+			color(0.126543f, 0.359464f, 0.458993f),
+			color(0.122973f, 0.351764f, 0.449573f),
+			color(0.119459f, 0.344084f, 0.440156f),
+			color(0.115998f, 0.336427f, 0.430745f),
+			color(0.112592f, 0.328795f, 0.421344f),
+			color(0.109239f, 0.321189f, 0.411957f),
+			color(0.105941f, 0.313614f, 0.402588f),
+			color(0.102696f, 0.306071f, 0.393239f),
+			color(0.099505f, 0.298562f, 0.383914f),
+			color(0.096367f, 0.291091f, 0.374617f),
+			color(0.093282f, 0.283658f, 0.365351f),
+			color(0.090251f, 0.276268f, 0.356120f),
+			color(0.087273f, 0.268922f, 0.346928f),
+			color(0.084347f, 0.261622f, 0.337778f),
+			color(0.081474f, 0.254371f, 0.328673f),
+			color(0.078654f, 0.247172f, 0.319618f),
+			color(0.075886f, 0.240026f, 0.310615f),
+			color(0.073171f, 0.232937f, 0.301668f),
+			color(0.070507f, 0.225907f, 0.292781f),
+			color(0.067895f, 0.218937f, 0.283958f),
+			color(0.065336f, 0.212031f, 0.275201f),
+			color(0.062828f, 0.205191f, 0.266515f),
+			color(0.060371f, 0.198419f, 0.257903f),
+			color(0.057966f, 0.191717f, 0.249368f),
+			color(0.055612f, 0.185089f, 0.240914f),
+			color(0.053309f, 0.178536f, 0.232545f),
+			color(0.051058f, 0.172062f, 0.224265f),
+			color(0.048857f, 0.165667f, 0.216076f),
+			color(0.046706f, 0.159355f, 0.207982f),
+			color(0.044606f, 0.153129f, 0.199987f),
+			color(0.042557f, 0.146990f, 0.192095f),
+			color(0.040558f, 0.140941f, 0.184308f),
+			color(0.038608f, 0.134984f, 0.176631f),
+			color(0.036709f, 0.129122f, 0.169067f),
+			color(0.034859f, 0.123357f, 0.161620f),
+			color(0.033060f, 0.117692f, 0.154293f),
+			color(0.031309f, 0.112128f, 0.147090f),
+			color(0.029608f, 0.106670f, 0.140014f),
+			color(0.027956f, 0.101318f, 0.133068f),
+			color(0.026353f, 0.096075f, 0.126257f),
+			color(0.024800f, 0.090944f, 0.119584f),
+			color(0.023294f, 0.085926f, 0.113053f),
+			color(0.021838f, 0.081026f, 0.106666f),
+			color(0.020430f, 0.076244f, 0.100428f),
+			color(0.019070f, 0.071583f, 0.094343f),
+			color(0.017759f, 0.067046f, 0.088413f),
+			color(0.016495f, 0.062635f, 0.082642f),
+			color(0.015279f, 0.058353f, 0.077034f),
+			color(0.014111f, 0.054202f, 0.071592f),
+			color(0.012991f, 0.050183f, 0.066320f),
+			color(0.011918f, 0.046301f, 0.061222f),
+			color(0.010892f, 0.042557f, 0.056300f),
+			color(0.009914f, 0.038953f, 0.051560f),
+			color(0.008983f, 0.035492f, 0.047003f),
+			color(0.008098f, 0.032176f, 0.042634f),
+			color(0.007260f, 0.029008f, 0.038456f),
+			color(0.006469f, 0.025991f, 0.034473f),
+			color(0.005724f, 0.023126f, 0.030688f),
+			color(0.005025f, 0.020416f, 0.027105f),
+			color(0.004373f, 0.017863f, 0.023728f),
+			color(0.003766f, 0.015470f, 0.020559f),
+			color(0.003206f, 0.013239f, 0.017603f),
+			color(0.002691f, 0.011173f, 0.014863f),
+			color(0.002221f, 0.009274f, 0.012343f),
+			color(0.001797f, 0.007545f, 0.010046f),
+			color(0.001419f, 0.005987f, 0.007975f),
+			color(0.001085f, 0.004603f, 0.006135f),
+			color(0.000796f, 0.003397f, 0.004529f),
+			color(0.000552f, 0.002369f, 0.003160f),
+			color(0.000353f, 0.001522f, 0.002032f),
+			color(0.000198f, 0.000860f, 0.001148f),
+			color(0.000088f, 0.000384f, 0.000513f),
+			color(0.000022f, 0.000096f, 0.000129f),
+			color(0.000000f, 0.000000f, 0.000000f),
+			color(0.000455f, 0.000043f, 0.000059f),
+			color(0.001795f, 0.000168f, 0.000231f),
+			color(0.003978f, 0.000373f, 0.000512f),
+			color(0.006966f, 0.000652f, 0.000895f),
+			color(0.010718f, 0.001003f, 0.001375f),
+			color(0.015195f, 0.001422f, 0.001947f),
+			color(0.020356f, 0.001904f, 0.002604f),
+			color(0.026161f, 0.002446f, 0.003343f),
+			color(0.032571f, 0.003044f, 0.004155f),
+			color(0.039546f, 0.003694f, 0.005037f),
+			color(0.047045f, 0.004392f, 0.005983f),
+			color(0.055030f, 0.005135f, 0.006987f),
+			color(0.063459f, 0.005918f, 0.008044f),
+			color(0.072293f, 0.006738f, 0.009147f),
+			color(0.081492f, 0.007591f, 0.010292f),
+			color(0.091015f, 0.008473f, 0.011473f),
+			color(0.100825f, 0.009380f, 0.012685f),
+			color(0.110879f, 0.010308f, 0.013921f),
+			color(0.121138f, 0.011255f, 0.015176f),
+			color(0.131563f, 0.012214f, 0.016445f),
+			color(0.142114f, 0.013184f, 0.017722f),
+			color(0.152749f, 0.014159f, 0.019002f),
+			color(0.163431f, 0.015137f, 0.020279f),
+			color(0.174118f, 0.016113f, 0.021547f),
+			color(0.184770f, 0.017084f, 0.022801f),
+			color(0.195348f, 0.018045f, 0.024036f),
+			color(0.205813f, 0.018993f, 0.025245f),
+			color(0.216123f, 0.019924f, 0.026424f),
+			color(0.226238f, 0.020834f, 0.027566f),
+			color(0.236120f, 0.021719f, 0.028666f),
+			color(0.245728f, 0.022576f, 0.029719f),
+			color(0.255023f, 0.023401f, 0.030719f),
+			color(0.263963f, 0.024189f, 0.031660f),
+			color(0.272510f, 0.024937f, 0.032537f),
+			color(0.280623f, 0.025641f, 0.033345f),
+			color(0.288262f, 0.026297f, 0.034077f),
+			color(0.295388f, 0.026902f, 0.034729f),
+			color(0.301961f, 0.027451f, 0.035294f),
+			color(0.308230f, 0.027924f, 0.035784f),
+			color(0.314470f, 0.028306f, 0.036213f),
+			color(0.320683f, 0.028601f, 0.036586f),
+			color(0.326867f, 0.028814f, 0.036904f),
+			color(0.333022f, 0.028950f, 0.037170f),
+			color(0.339148f, 0.029013f, 0.037387f),
+			color(0.345244f, 0.029007f, 0.037558f),
+			color(0.351310f, 0.028938f, 0.037686f),
+			color(0.357345f, 0.028810f, 0.037772f),
+			color(0.363350f, 0.028626f, 0.037820f),
+			color(0.369323f, 0.028393f, 0.037833f),
+			color(0.375265f, 0.028115f, 0.037813f),
+			color(0.381174f, 0.027795f, 0.037762f),
+			color(0.387051f, 0.027440f, 0.037684f),
+			color(0.392896f, 0.027052f, 0.037582f),
+			color(0.398707f, 0.026638f, 0.037457f),
+			color(0.404484f, 0.026201f, 0.037312f),
+			color(0.410228f, 0.025745f, 0.037152f),
+			color(0.415937f, 0.025277f, 0.036977f),
+			color(0.421611f, 0.024799f, 0.036790f),
+			color(0.427250f, 0.024318f, 0.036596f),
+			color(0.432854f, 0.023836f, 0.036395f),
+			color(0.438422f, 0.023360f, 0.036191f),
+			color(0.443954f, 0.022893f, 0.035986f),
+			color(0.449448f, 0.022440f, 0.035784f),
+			color(0.454906f, 0.022005f, 0.035586f),
+			color(0.460327f, 0.021594f, 0.035396f),
+			color(0.465709f, 0.021211f, 0.035216f),
+			color(0.471054f, 0.020860f, 0.035049f),
+			color(0.476360f, 0.020545f, 0.034898f),
+			color(0.481626f, 0.020273f, 0.034765f),
+			color(0.486854f, 0.020046f, 0.034653f),
+			color(0.492042f, 0.019870f, 0.034565f),
+			color(0.497189f, 0.019749f, 0.034503f),
+			color(0.502297f, 0.019688f, 0.034470f),
+			color(0.507363f, 0.019692f, 0.034469f),
+			color(0.512388f, 0.019764f, 0.034502f),
+			color(0.517371f, 0.019910f, 0.034573f),
+			color(0.522312f, 0.020134f, 0.034683f),
+			color(0.527211f, 0.020440f, 0.034836f),
+			color(0.532067f, 0.020834f, 0.035035f),
+			color(0.536880f, 0.021320f, 0.035281f),
+			color(0.541649f, 0.021902f, 0.035578f),
+			color(0.546375f, 0.022585f, 0.035928f),
+			color(0.551056f, 0.023374f, 0.036334f),
+			color(0.555692f, 0.024272f, 0.036799f),
+			color(0.560283f, 0.025286f, 0.037325f),
+			color(0.564828f, 0.026419f, 0.037916f),
+			color(0.569328f, 0.027675f, 0.038573f),
+			color(0.573782f, 0.029060f, 0.039299f),
+			color(0.578188f, 0.030578f, 0.040098f),
+			color(0.582548f, 0.032234f, 0.040972f),
+			color(0.586860f, 0.034031f, 0.041923f),
+			color(0.591125f, 0.035976f, 0.042955f),
+			color(0.595341f, 0.038072f, 0.044069f),
+			color(0.599509f, 0.040323f, 0.045269f),
+			color(0.603628f, 0.042736f, 0.046558f),
+			color(0.607697f, 0.045313f, 0.047937f),
+			color(0.611717f, 0.048059f, 0.049411f),
+			color(0.615686f, 0.050980f, 0.050980f),
+			color(0.619647f, 0.054017f, 0.052605f),
+			color(0.623641f, 0.057107f, 0.054240f),
+			color(0.627665f, 0.060250f, 0.055887f),
+			color(0.631719f, 0.063444f, 0.057545f),
+			color(0.635802f, 0.066690f, 0.059214f),
+			color(0.639913f, 0.069985f, 0.060895f),
+			color(0.644049f, 0.073331f, 0.062587f),
+			color(0.648211f, 0.076725f, 0.064290f),
+			color(0.652396f, 0.080167f, 0.066005f),
+			color(0.656604f, 0.083656f, 0.067732f),
+			color(0.660833f, 0.087192f, 0.069470f),
+			color(0.665082f, 0.090773f, 0.071219f),
+			color(0.669350f, 0.094399f, 0.072981f),
+			color(0.673636f, 0.098069f, 0.074754f),
+			color(0.677938f, 0.101783f, 0.076539f),
+			color(0.682255f, 0.105538f, 0.078336f),
+			color(0.686586f, 0.109336f, 0.080145f),
+			color(0.690930f, 0.113175f, 0.081966f),
+			color(0.695285f, 0.117053f, 0.083798f),
+			color(0.699651f, 0.120971f, 0.085643f),
+			color(0.704025f, 0.124928f, 0.087500f),
+			color(0.708407f, 0.128922f, 0.089369f),
+			color(0.712796f, 0.132954f, 0.091251f),
+			color(0.717190f, 0.137021f, 0.093144f),
+			color(0.721588f, 0.141124f, 0.095050f),
+			color(0.725990f, 0.145262f, 0.096968f),
+			color(0.730392f, 0.149434f, 0.098899f),
+			color(0.734795f, 0.153638f, 0.100842f),
+			color(0.739198f, 0.157875f, 0.102798f),
+			color(0.743598f, 0.162144f, 0.104766f),
+			color(0.747995f, 0.166444f, 0.106747f),
+			color(0.752387f, 0.170773f, 0.108740f),
+			color(0.756774f, 0.175132f, 0.110746f),
+			color(0.761154f, 0.179519f, 0.112765f),
+			color(0.765525f, 0.183933f, 0.114797f),
+			color(0.769888f, 0.188375f, 0.116842f),
+			color(0.774239f, 0.192842f, 0.118899f),
+			color(0.778579f, 0.197335f, 0.120970f),
+			color(0.782905f, 0.201853f, 0.123053f),
+			color(0.787217f, 0.206394f, 0.125150f),
+			color(0.791514f, 0.210958f, 0.127259f),
+			color(0.795794f, 0.215544f, 0.129382f),
+			color(0.800056f, 0.220152f, 0.131518f),
+			color(0.804298f, 0.224780f, 0.133668f),
+			color(0.808520f, 0.229429f, 0.135831f),
+			color(0.812721f, 0.234096f, 0.138007f),
+			color(0.816898f, 0.238781f, 0.140196f),
+			color(0.821051f, 0.243484f, 0.142399f),
+			color(0.825179f, 0.248204f, 0.144616f),
+			color(0.829281f, 0.252939f, 0.146846f),
+			color(0.833354f, 0.257690f, 0.149089f),
+			color(0.837398f, 0.262455f, 0.151347f),
+			color(0.841412f, 0.267234f, 0.153618f),
+			color(0.845395f, 0.272025f, 0.155903f),
+			color(0.849345f, 0.276829f, 0.158201f),
+			color(0.853260f, 0.281643f, 0.160514f),
+			color(0.857141f, 0.286469f, 0.162840f),
+			color(0.860985f, 0.291303f, 0.165181f),
+			color(0.864791f, 0.296147f, 0.167535f),
+			color(0.868559f, 0.300999f, 0.169904f),
+			color(0.872286f, 0.305858f, 0.172287f),
+			color(0.875972f, 0.310724f, 0.174684f),
+			color(0.879616f, 0.315596f, 0.177095f),
+			color(0.883215f, 0.320472f, 0.179520f),
+			color(0.886770f, 0.325353f, 0.181960f),
+			color(0.890278f, 0.330237f, 0.184414f),
+			color(0.893739f, 0.335124f, 0.186883f),
+			color(0.897151f, 0.340012f, 0.189366f),
+			color(0.900513f, 0.344902f, 0.191863f),
+			color(0.903824f, 0.349792f, 0.194375f),
+			color(0.907083f, 0.354682f, 0.196902f),
+			color(0.910288f, 0.359570f, 0.199444f),
+			color(0.913438f, 0.364456f, 0.202000f),
+			color(0.916532f, 0.369339f, 0.204571f),
+			color(0.919568f, 0.374219f, 0.207157f),
+			color(0.922546f, 0.379095f, 0.209758f),
+			color(0.925464f, 0.383965f, 0.212373f),
+			color(0.928322f, 0.388829f, 0.215004f),
+			color(0.931117f, 0.393687f, 0.217650f),
+			color(0.933848f, 0.398537f, 0.220310f),
+			color(0.936515f, 0.403379f, 0.222986f),
+			color(0.939116f, 0.408211f, 0.225677f),
+			color(0.941649f, 0.413034f, 0.228384f),
+			color(0.944115f, 0.417846f, 0.231105f),
+			color(0.946511f, 0.422647f, 0.233842f),
+			color(0.948835f, 0.427436f, 0.236595f),
+			color(0.951088f, 0.432211f, 0.239363f),
+			color(0.953268f, 0.436973f, 0.242146f),
+			color(0.955373f, 0.441720f, 0.244945f),
+			color(0.957402f, 0.446452f, 0.247759f),
+			color(0.959354f, 0.451168f, 0.250589f),
+			color(0.961228f, 0.455867f, 0.253435f),
+			color(0.963023f, 0.460549f, 0.256297f),
+			color(0.964737f, 0.465212f, 0.259174f),
+			color(0.966369f, 0.469855f, 0.262067f),
+			color(0.967918f, 0.474479f, 0.264976f),
+			color(0.969382f, 0.479082f, 0.267902f),
+			color(0.970761f, 0.483663f, 0.270843f),
+			color(0.972053f, 0.488222f, 0.273800f),
+			color(0.973257f, 0.492758f, 0.276773f),
+			color(0.974372f, 0.497269f, 0.279762f),
+			color(0.975396f, 0.501757f, 0.282768f),
+			color(0.976329f, 0.506218f, 0.285790f),
+			color(0.977169f, 0.510654f, 0.288828f),
+			color(0.977914f, 0.515062f, 0.291882f),
+			color(0.978564f, 0.519443f, 0.294953f),
+			color(0.979118f, 0.523795f, 0.298040f),
+			color(0.979573f, 0.528117f, 0.301144f),
+			color(0.979930f, 0.532410f, 0.304265f),
+			color(0.980186f, 0.536671f, 0.307402f),
+			color(0.980340f, 0.540901f, 0.310555f),
+			color(0.980392f, 0.545098f, 0.313725f),
+			color(0.980390f, 0.549309f, 0.316912f),
+			color(0.980383f, 0.553579f, 0.320115f),
+			color(0.980372f, 0.557907f, 0.323333f),
+			color(0.980356f, 0.562291f, 0.326567f),
+			color(0.980335f, 0.566728f, 0.329816f),
+			color(0.980310f, 0.571219f, 0.333081f),
+			color(0.980281f, 0.575760f, 0.336362f),
+			color(0.980247f, 0.580350f, 0.339659f),
+			color(0.980209f, 0.584988f, 0.342970f),
+			color(0.980167f, 0.589671f, 0.346298f),
+			color(0.980120f, 0.594399f, 0.349640f),
+			color(0.980069f, 0.599169f, 0.352998f),
+			color(0.980013f, 0.603979f, 0.356371f),
+			color(0.979954f, 0.608829f, 0.359760f),
+			color(0.979890f, 0.613715f, 0.363164f),
+			color(0.979822f, 0.618638f, 0.366583f),
+			color(0.979749f, 0.623594f, 0.370017f),
+			color(0.979673f, 0.628582f, 0.373466f),
+			color(0.979593f, 0.633601f, 0.376930f),
+			color(0.979508f, 0.638649f, 0.380409f),
+			color(0.979419f, 0.643724f, 0.383903f),
+			color(0.979327f, 0.648824f, 0.387412f),
+			color(0.979230f, 0.653948f, 0.390936f),
+			color(0.979129f, 0.659094f, 0.394475f),
+			color(0.979025f, 0.664260f, 0.398028f),
+			color(0.978916f, 0.669445f, 0.401596f),
+			color(0.978804f, 0.674647f, 0.405179f),
+			color(0.978688f, 0.679864f, 0.408776f),
+			color(0.978568f, 0.685095f, 0.412388f),
+			color(0.978444f, 0.690338f, 0.416015f),
+			color(0.978316f, 0.695591f, 0.419656f),
+			color(0.978185f, 0.700852f, 0.423311f),
+			color(0.978049f, 0.706120f, 0.426981f),
+			color(0.977910f, 0.711394f, 0.430665f),
+			color(0.977768f, 0.716670f, 0.434363f),
+			color(0.977622f, 0.721949f, 0.438076f),
+			color(0.977472f, 0.727227f, 0.441803f),
+			color(0.977318f, 0.732504f, 0.445544f),
+			color(0.977161f, 0.737778f, 0.449299f),
+			color(0.977001f, 0.743046f, 0.453069f),
+			color(0.976837f, 0.748308f, 0.456852f),
+			color(0.976669f, 0.753561f, 0.460649f),
+			color(0.976498f, 0.758804f, 0.464460f),
+			color(0.976324f, 0.764035f, 0.468286f),
+			color(0.976146f, 0.769253f, 0.472125f),
+			color(0.975965f, 0.774456f, 0.475977f),
+			color(0.975780f, 0.779642f, 0.479844f),
+			color(0.975592f, 0.784809f, 0.483724f),
+			color(0.975401f, 0.789956f, 0.487618f),
+			color(0.975207f, 0.795081f, 0.491525f),
+			color(0.975009f, 0.800182f, 0.495447f),
+			color(0.974808f, 0.805258f, 0.499381f),
+			color(0.974604f, 0.810307f, 0.503329f),
+			color(0.974397f, 0.815327f, 0.507291f),
+			color(0.974186f, 0.820317f, 0.511266f),
+			color(0.973973f, 0.825274f, 0.515254f),
+			color(0.973756f, 0.830198f, 0.519256f),
+			color(0.973537f, 0.835086f, 0.523271f),
+			color(0.973314f, 0.839937f, 0.527299f),
+			color(0.973088f, 0.844749f, 0.531340f),
+			color(0.972860f, 0.849521f, 0.535394f),
+			color(0.972628f, 0.854250f, 0.539462f),
+			color(0.972394f, 0.858936f, 0.543542f),
+			color(0.972157f, 0.863575f, 0.547635f),
+			color(0.971916f, 0.868168f, 0.551742f),
+			color(0.971673f, 0.872711f, 0.555861f),
+			color(0.971428f, 0.877203f, 0.559993f),
+			color(0.971179f, 0.881644f, 0.564138f),
+			color(0.970928f, 0.886029f, 0.568296f),
+			color(0.970673f, 0.890360f, 0.572466f),
+			color(0.970417f, 0.894632f, 0.576649f),
+			color(0.970157f, 0.898846f, 0.580845f),
+			color(0.969895f, 0.902998f, 0.585053f),
+			color(0.969630f, 0.907088f, 0.589274f),
+			color(0.969363f, 0.911114f, 0.593507f),
+			color(0.969093f, 0.915074f, 0.597753f),
+			color(0.968821f, 0.918966f, 0.602011f),
+			color(0.968546f, 0.922788f, 0.606281f),
+			color(0.968269f, 0.926540f, 0.610564f),
+			color(0.967989f, 0.930219f, 0.614859f),
+			color(0.967707f, 0.933823f, 0.619166f),
+			color(0.967422f, 0.937351f, 0.623485f),
+			color(0.967135f, 0.940802f, 0.627817f),
+			color(0.966846f, 0.944173f, 0.632160f),
+			color(0.966554f, 0.947463f, 0.636516f),
+			color(0.966260f, 0.950670f, 0.640883f),
+			color(0.965964f, 0.953792f, 0.645263f),
+			color(0.965665f, 0.956828f, 0.649654f),
+			color(0.965365f, 0.959776f, 0.654057f),
+			color(0.965062f, 0.962634f, 0.658472f),
+			color(0.964757f, 0.965401f, 0.662899f),
+			color(0.964450f, 0.968075f, 0.667338f),
+			color(0.964141f, 0.970654f, 0.671788f),
+			color(0.963829f, 0.973137f, 0.676249f),
+			color(0.963516f, 0.975522f, 0.680723f),
+			color(0.963201f, 0.977807f, 0.685208f),
+			color(0.962883f, 0.979990f, 0.689704f),
+			color(0.962564f, 0.982070f, 0.694212f),
+			color(0.962243f, 0.984045f, 0.698731f),
+			color(0.961920f, 0.985914f, 0.703261f),
+			color(0.961595f, 0.987674f, 0.707803f),
+			color(0.961268f, 0.989324f, 0.712356f),
+			color(0.960939f, 0.990863f, 0.716920f),
+			color(0.960609f, 0.992288f, 0.721496f),
+			color(0.960276f, 0.993598f, 0.726082f),
+			color(0.959943f, 0.994792f, 0.730680f),
+			color(0.959607f, 0.995867f, 0.735289f),
+			color(0.959269f, 0.996822f, 0.739908f),
+			color(0.958930f, 0.997655f, 0.744539f),
+			color(0.958590f, 0.998364f, 0.749180f),
+			color(0.958247f, 0.998949f, 0.753832f),
+			color(0.957904f, 0.999406f, 0.758495f),
+			color(0.957558f, 0.999735f, 0.763169f),
+			color(0.957211f, 0.999933f, 0.767854f),
+			color(0.956863f, 1.000000f, 0.772549f),
+			color(0.956724f, 1.000000f, 0.777646f),
+			color(0.956974f, 1.000000f, 0.783494f),
+			color(0.957569f, 1.000000f, 0.790031f),
+			color(0.958462f, 1.000000f, 0.797195f),
+			color(0.959609f, 1.000000f, 0.804924f),
+			color(0.960963f, 1.000000f, 0.813155f),
+			color(0.962480f, 1.000000f, 0.821825f),
+			color(0.964114f, 1.000000f, 0.830874f),
+			color(0.965820f, 1.000000f, 0.840237f),
+			color(0.967551f, 1.000000f, 0.849854f),
+			color(0.969263f, 1.000000f, 0.859662f),
+			color(0.970910f, 1.000000f, 0.869598f),
+			color(0.972447f, 1.000000f, 0.879601f),
+			color(0.973827f, 1.000000f, 0.889608f),
+			color(0.975007f, 1.000000f, 0.899556f),
+			color(0.975940f, 1.000000f, 0.909384f),
+			color(0.976580f, 1.000000f, 0.919029f),
+			color(0.976883f, 1.000000f, 0.928429f),
+			color(0.976803f, 1.000000f, 0.937522f),
+			color(0.976294f, 1.000000f, 0.946246f),
+			color(0.975312f, 1.000000f, 0.954537f),
+			color(0.973809f, 1.000000f, 0.962334f),
+			color(0.971742f, 1.000000f, 0.969575f),
+			color(0.969065f, 1.000000f, 0.976197f),
+			color(0.965731f, 1.000000f, 0.982139f),
+			color(0.961696f, 1.000000f, 0.987337f),
+			color(0.956915f, 1.000000f, 0.991730f),
+			color(0.951341f, 1.000000f, 0.995254f),
+			color(0.944930f, 1.000000f, 0.997849f),
+			color(0.937635f, 1.000000f, 0.999452f)
+		},
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383, 384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399, 400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413, 414, 415, 416, 417, 418, 419, 420, 421, 422, 423, 424, 425, 426, 427, 428, 429, 430, 431, 432, 433, 434, 435, 436, 437, 438, 439, 440, 441, 442, 443, 444, 445, 446, 447, 448, 449, 450, 451, 452, 453, 454, 455, 456, 457, 458, 459, 460, 461, 462, 463, 464, 465, 466, 467, 468, 469, 470, 471, 472, 473, 474, 475, 476, 477, 478, 479, 480, 481, 482, 483, 484, 485, 486, 487, 488, 489, 490, 491, 492, 493, 494, 495, 496, 497, 498, 499, 500, 501, 502, 503, 504, 505, 506, 507, 508, 509, 510, 511 }
+	);
+	return gradient;
+}
 
-#include "Gradient.h"
-Gradient uf_default(
-	400,
-	{
-		color(0.000000f, 0.027451f, 0.392157f),
-		color(0.000006f, 0.030944f, 0.398769f),
-		color(0.000025f, 0.034613f, 0.405445f),
-		color(0.000060f, 0.038454f, 0.412182f),
-		color(0.000113f, 0.042462f, 0.418975f),
-		color(0.000186f, 0.046633f, 0.425821f),
-		color(0.000282f, 0.050963f, 0.432717f),
-		color(0.000403f, 0.055447f, 0.439660f),
-		color(0.000551f, 0.060080f, 0.446644f),
-		color(0.000730f, 0.064858f, 0.453668f),
-		color(0.000940f, 0.069776f, 0.460727f),
-		color(0.001185f, 0.074831f, 0.467818f),
-		color(0.001467f, 0.080017f, 0.474938f),
-		color(0.001789f, 0.085329f, 0.482082f),
-		color(0.002151f, 0.090765f, 0.489247f),
-		color(0.002558f, 0.096319f, 0.496430f),
-		color(0.003011f, 0.101986f, 0.503628f),
-		color(0.003513f, 0.107762f, 0.510836f),
-		color(0.004066f, 0.113643f, 0.518050f),
-		color(0.004672f, 0.119623f, 0.525269f),
-		color(0.005334f, 0.125700f, 0.532487f),
-		color(0.006054f, 0.131867f, 0.539701f),
-		color(0.006835f, 0.138122f, 0.546909f),
-		color(0.007678f, 0.144458f, 0.554106f),
-		color(0.008587f, 0.150872f, 0.561288f),
-		color(0.009563f, 0.157359f, 0.568452f),
-		color(0.010610f, 0.163915f, 0.575596f),
-		color(0.011728f, 0.170535f, 0.582714f),
-		color(0.012921f, 0.177215f, 0.589803f),
-		color(0.014191f, 0.183950f, 0.596861f),
-		color(0.015541f, 0.190736f, 0.603883f),
-		color(0.016972f, 0.197568f, 0.610866f),
-		color(0.018487f, 0.204442f, 0.617806f),
-		color(0.020089f, 0.211353f, 0.624700f),
-		color(0.021780f, 0.218297f, 0.631544f),
-		color(0.023561f, 0.225269f, 0.638335f),
-		color(0.025437f, 0.232265f, 0.645068f),
-		color(0.027408f, 0.239280f, 0.651742f),
-		color(0.029477f, 0.246310f, 0.658351f),
-		color(0.031647f, 0.253351f, 0.664893f),
-		color(0.033920f, 0.260397f, 0.671363f),
-		color(0.036298f, 0.267445f, 0.677759f),
-		color(0.038784f, 0.274490f, 0.684077f),
-		color(0.041380f, 0.281527f, 0.690312f),
-		color(0.044088f, 0.288552f, 0.696463f),
-		color(0.046911f, 0.295560f, 0.702524f),
-		color(0.049851f, 0.302548f, 0.708493f),
-		color(0.052911f, 0.309510f, 0.714367f),
-		color(0.056092f, 0.316442f, 0.720140f),
-		color(0.059398f, 0.323339f, 0.725811f),
-		color(0.062830f, 0.330197f, 0.731374f),
-		color(0.066391f, 0.337012f, 0.736828f),
-		color(0.070084f, 0.343779f, 0.742168f),
-		color(0.073910f, 0.350494f, 0.747390f),
-		color(0.077872f, 0.357151f, 0.752492f),
-		color(0.081972f, 0.363747f, 0.757469f),
-		color(0.086213f, 0.370277f, 0.762318f),
-		color(0.090597f, 0.376737f, 0.767036f),
-		color(0.095127f, 0.383122f, 0.771619f),
-		color(0.099804f, 0.389428f, 0.776062f),
-		color(0.104632f, 0.395649f, 0.780364f),
-		color(0.109612f, 0.401783f, 0.784520f),
-		color(0.114747f, 0.407823f, 0.788527f),
-		color(0.120039f, 0.413766f, 0.792381f),
-		color(0.125490f, 0.419608f, 0.796078f),
-		color(0.131095f, 0.425446f, 0.799683f),
-		color(0.136843f, 0.431380f, 0.803262f),
-		color(0.142731f, 0.437408f, 0.806815f),
-		color(0.148755f, 0.443526f, 0.810341f),
-		color(0.154914f, 0.449732f, 0.813840f),
-		color(0.161205f, 0.456022f, 0.817312f),
-		color(0.167623f, 0.462393f, 0.820758f),
-		color(0.174166f, 0.468843f, 0.824176f),
-		color(0.180831f, 0.475369f, 0.827567f),
-		color(0.187616f, 0.481966f, 0.830930f),
-		color(0.194516f, 0.488634f, 0.834265f),
-		color(0.201530f, 0.495368f, 0.837573f),
-		color(0.208654f, 0.502165f, 0.840852f),
-		color(0.215885f, 0.509023f, 0.844104f),
-		color(0.223220f, 0.515939f, 0.847326f),
-		color(0.230656f, 0.522909f, 0.850521f),
-		color(0.238190f, 0.529930f, 0.853686f),
-		color(0.245820f, 0.537001f, 0.856823f),
-		color(0.253542f, 0.544117f, 0.859931f),
-		color(0.261352f, 0.551276f, 0.863009f),
-		color(0.269249f, 0.558474f, 0.866058f),
-		color(0.277230f, 0.565710f, 0.869077f),
-		color(0.285290f, 0.572978f, 0.872067f),
-		color(0.293428f, 0.580278f, 0.875027f),
-		color(0.301639f, 0.587606f, 0.877957f),
-		color(0.309922f, 0.594958f, 0.880856f),
-		color(0.318273f, 0.602332f, 0.883725f),
-		color(0.326690f, 0.609725f, 0.886564f),
-		color(0.335168f, 0.617134f, 0.889371f),
-		color(0.343706f, 0.624556f, 0.892148f),
-		color(0.352300f, 0.631987f, 0.894894f),
-		color(0.360948f, 0.639426f, 0.897608f),
-		color(0.369645f, 0.646868f, 0.900291f),
-		color(0.378390f, 0.654312f, 0.902943f),
-		color(0.387179f, 0.661753f, 0.905562f),
-		color(0.396010f, 0.669190f, 0.908150f),
-		color(0.404878f, 0.676618f, 0.910706f),
-		color(0.413782f, 0.684036f, 0.913229f),
-		color(0.422718f, 0.691439f, 0.915720f),
-		color(0.431684f, 0.698826f, 0.918179f),
-		color(0.440676f, 0.706192f, 0.920604f),
-		color(0.449691f, 0.713536f, 0.922997f),
-		color(0.458726f, 0.720854f, 0.925356f),
-		color(0.467779f, 0.728143f, 0.927683f),
-		color(0.476846f, 0.735401f, 0.929975f),
-		color(0.485924f, 0.742623f, 0.932235f),
-		color(0.495011f, 0.749808f, 0.934460f),
-		color(0.504103f, 0.756952f, 0.936652f),
-		color(0.513198f, 0.764052f, 0.938809f),
-		color(0.522291f, 0.771106f, 0.940932f),
-		color(0.531381f, 0.778110f, 0.943021f),
-		color(0.540465f, 0.785061f, 0.945075f),
-		color(0.549539f, 0.791956f, 0.947094f),
-		color(0.558600f, 0.798793f, 0.949078f),
-		color(0.567646f, 0.805568f, 0.951027f),
-		color(0.576673f, 0.812279f, 0.952941f),
-		color(0.585678f, 0.818922f, 0.954820f),
-		color(0.594659f, 0.825494f, 0.956662f),
-		color(0.603612f, 0.831993f, 0.958469f),
-		color(0.612535f, 0.838416f, 0.960240f),
-		color(0.621424f, 0.844758f, 0.961975f),
-		color(0.630277f, 0.851019f, 0.963674f),
-		color(0.639090f, 0.857194f, 0.965336f),
-		color(0.647860f, 0.863280f, 0.966961f),
-		color(0.656585f, 0.869275f, 0.968550f),
-		color(0.665261f, 0.875176f, 0.970101f),
-		color(0.673886f, 0.880979f, 0.971616f),
-		color(0.682456f, 0.886682f, 0.973093f),
-		color(0.690969f, 0.892282f, 0.974533f),
-		color(0.699421f, 0.897775f, 0.975935f),
-		color(0.707810f, 0.903159f, 0.977299f),
-		color(0.716132f, 0.908430f, 0.978625f),
-		color(0.724385f, 0.913587f, 0.979913f),
-		color(0.732565f, 0.918625f, 0.981163f),
-		color(0.740669f, 0.923542f, 0.982374f),
-		color(0.748696f, 0.928334f, 0.983547f),
-		color(0.756640f, 0.933000f, 0.984681f),
-		color(0.764501f, 0.937535f, 0.985776f),
-		color(0.772273f, 0.941937f, 0.986831f),
-		color(0.779956f, 0.946203f, 0.987847f),
-		color(0.787545f, 0.950330f, 0.988824f),
-		color(0.795037f, 0.954315f, 0.989761f),
-		color(0.802430f, 0.958155f, 0.990659f),
-		color(0.809721f, 0.961846f, 0.991516f),
-		color(0.816906f, 0.965387f, 0.992333f),
-		color(0.823983f, 0.968774f, 0.993110f),
-		color(0.830948f, 0.972003f, 0.993846f),
-		color(0.837799f, 0.975073f, 0.994541f),
-		color(0.844532f, 0.977980f, 0.995196f),
-		color(0.851146f, 0.980721f, 0.995810f),
-		color(0.857635f, 0.983292f, 0.996382f),
-		color(0.863999f, 0.985692f, 0.996913f),
-		color(0.870233f, 0.987918f, 0.997403f),
-		color(0.876334f, 0.989965f, 0.997851f),
-		color(0.882301f, 0.991831f, 0.998257f),
-		color(0.888129f, 0.993514f, 0.998621f),
-		color(0.893815f, 0.995010f, 0.998943f),
-		color(0.899357f, 0.996316f, 0.999222f),
-		color(0.904752f, 0.997429f, 0.999459f),
-		color(0.909997f, 0.998347f, 0.999653f),
-		color(0.915088f, 0.999066f, 0.999805f),
-		color(0.920023f, 0.999583f, 0.999913f),
-		color(0.924798f, 0.999895f, 0.999978f),
-		color(0.929412f, 1.000000f, 1.000000f),
-		color(0.933868f, 0.999938f, 0.999624f),
-		color(0.938177f, 0.999752f, 0.998508f),
-		color(0.942339f, 0.999443f, 0.996668f),
-		color(0.946359f, 0.999014f, 0.994122f),
-		color(0.950237f, 0.998465f, 0.990886f),
-		color(0.953976f, 0.997798f, 0.986978f),
-		color(0.957578f, 0.997014f, 0.982415f),
-		color(0.961046f, 0.996115f, 0.977213f),
-		color(0.964381f, 0.995101f, 0.971390f),
-		color(0.967586f, 0.993975f, 0.964963f),
-		color(0.970663f, 0.992738f, 0.957949f),
-		color(0.973615f, 0.991391f, 0.950364f),
-		color(0.976443f, 0.989935f, 0.942226f),
-		color(0.979150f, 0.988372f, 0.933552f),
-		color(0.981739f, 0.986703f, 0.924358f),
-		color(0.984210f, 0.984930f, 0.914663f),
-		color(0.986567f, 0.983054f, 0.904482f),
-		color(0.988812f, 0.981076f, 0.893834f),
-		color(0.990946f, 0.978998f, 0.882734f),
-		color(0.992973f, 0.976821f, 0.871200f),
-		color(0.994895f, 0.974547f, 0.859249f),
-		color(0.996713f, 0.972176f, 0.846898f),
-		color(0.998429f, 0.969711f, 0.834164f),
-		color(1.000047f, 0.967153f, 0.821064f),
-		color(1.001569f, 0.964502f, 0.807616f),
-		color(1.002996f, 0.961761f, 0.793835f),
-		color(1.004331f, 0.958930f, 0.779739f),
-		color(1.005575f, 0.956012f, 0.765346f),
-		color(1.006733f, 0.953007f, 0.750671f),
-		color(1.007804f, 0.949917f, 0.735733f),
-		color(1.008793f, 0.946744f, 0.720548f),
-		color(1.009700f, 0.943488f, 0.705133f),
-		color(1.010528f, 0.940151f, 0.689505f),
-		color(1.011280f, 0.936735f, 0.673682f),
-		color(1.011958f, 0.933240f, 0.657680f),
-		color(1.012564f, 0.929669f, 0.641516f),
-		color(1.013099f, 0.926022f, 0.625208f),
-		color(1.013567f, 0.922301f, 0.608771f),
-		color(1.013970f, 0.918508f, 0.592225f),
-		color(1.014309f, 0.914643f, 0.575584f),
-		color(1.014588f, 0.910708f, 0.558867f),
-		color(1.014808f, 0.906705f, 0.542091f),
-		color(1.014971f, 0.902635f, 0.525271f),
-		color(1.015080f, 0.898498f, 0.508427f),
-		color(1.015137f, 0.894298f, 0.491573f),
-		color(1.015144f, 0.890034f, 0.474729f),
-		color(1.015104f, 0.885709f, 0.457909f),
-		color(1.015018f, 0.881324f, 0.441133f),
-		color(1.014889f, 0.876879f, 0.424416f),
-		color(1.014720f, 0.872378f, 0.407775f),
-		color(1.014511f, 0.867820f, 0.391229f),
-		color(1.014267f, 0.863207f, 0.374792f),
-		color(1.013988f, 0.858541f, 0.358484f),
-		color(1.013677f, 0.853823f, 0.342320f),
-		color(1.013336f, 0.849054f, 0.326318f),
-		color(1.012968f, 0.844237f, 0.310495f),
-		color(1.012575f, 0.839371f, 0.294867f),
-		color(1.012158f, 0.834459f, 0.279452f),
-		color(1.011721f, 0.829502f, 0.264267f),
-		color(1.011266f, 0.824501f, 0.249329f),
-		color(1.010793f, 0.819457f, 0.234654f),
-		color(1.010307f, 0.814373f, 0.220261f),
-		color(1.009809f, 0.809250f, 0.206165f),
-		color(1.009302f, 0.804088f, 0.192384f),
-		color(1.008786f, 0.798889f, 0.178936f),
-		color(1.008266f, 0.793655f, 0.165836f),
-		color(1.007743f, 0.788387f, 0.153102f),
-		color(1.007219f, 0.783086f, 0.140751f),
-		color(1.006697f, 0.777754f, 0.128800f),
-		color(1.006178f, 0.772392f, 0.117266f),
-		color(1.005665f, 0.767001f, 0.106166f),
-		color(1.005161f, 0.761584f, 0.095518f),
-		color(1.004667f, 0.756140f, 0.085337f),
-		color(1.004185f, 0.750672f, 0.075642f),
-		color(1.003719f, 0.745182f, 0.066448f),
-		color(1.003269f, 0.739669f, 0.057774f),
-		color(1.002839f, 0.734136f, 0.049636f),
-		color(1.002431f, 0.728585f, 0.042051f),
-		color(1.002046f, 0.723016f, 0.035037f),
-		color(1.001687f, 0.717431f, 0.028610f),
-		color(1.001357f, 0.711831f, 0.022787f),
-		color(1.001057f, 0.706217f, 0.017585f),
-		color(1.000790f, 0.700592f, 0.013022f),
-		color(1.000558f, 0.694956f, 0.009114f),
-		color(1.000363f, 0.689311f, 0.005878f),
-		color(1.000208f, 0.683658f, 0.003332f),
-		color(1.000094f, 0.677999f, 0.001492f),
-		color(1.000024f, 0.672335f, 0.000376f),
-		color(1.000000f, 0.666667f, 0.000000f),
-		color(0.999598f, 0.660863f, 0.000000f),
-		color(0.998403f, 0.654797f, 0.000000f),
-		color(0.996434f, 0.648475f, 0.000000f),
-		color(0.993711f, 0.641906f, 0.000000f),
-		color(0.990252f, 0.635098f, 0.000000f),
-		color(0.986077f, 0.628058f, 0.000000f),
-		color(0.981203f, 0.620794f, 0.000000f),
-		color(0.975650f, 0.613314f, 0.000000f),
-		color(0.969437f, 0.605626f, 0.000000f),
-		color(0.962582f, 0.597738f, 0.000000f),
-		color(0.955105f, 0.589658f, 0.000000f),
-		color(0.947024f, 0.581392f, 0.000000f),
-		color(0.938358f, 0.572950f, 0.000000f),
-		color(0.929126f, 0.564339f, 0.000000f),
-		color(0.919347f, 0.555567f, 0.000000f),
-		color(0.909039f, 0.546642f, 0.000000f),
-		color(0.898223f, 0.537570f, 0.000000f),
-		color(0.886916f, 0.528362f, 0.000000f),
-		color(0.875137f, 0.519023f, 0.000000f),
-		color(0.862905f, 0.509563f, 0.000000f),
-		color(0.850240f, 0.499988f, 0.000000f),
-		color(0.837159f, 0.490307f, 0.000000f),
-		color(0.823682f, 0.480528f, 0.000000f),
-		color(0.809828f, 0.470657f, 0.000000f),
-		color(0.795615f, 0.460704f, 0.000000f),
-		color(0.781063f, 0.450676f, 0.000000f),
-		color(0.766190f, 0.440581f, 0.000000f),
-		color(0.751016f, 0.430426f, 0.000000f),
-		color(0.735558f, 0.420220f, 0.000000f),
-		color(0.719836f, 0.409970f, 0.000000f),
-		color(0.703869f, 0.399684f, 0.000000f),
-		color(0.687675f, 0.389371f, 0.000000f),
-		color(0.671274f, 0.379037f, 0.000000f),
-		color(0.654684f, 0.368690f, 0.000000f),
-		color(0.637925f, 0.358339f, 0.000000f),
-		color(0.621015f, 0.347992f, 0.000000f),
-		color(0.603972f, 0.337655f, 0.000000f),
-		color(0.586816f, 0.327338f, 0.000000f),
-		color(0.569566f, 0.317047f, 0.000000f),
-		color(0.552241f, 0.306791f, 0.000000f),
-		color(0.534859f, 0.296577f, 0.000000f),
-		color(0.517439f, 0.286414f, 0.000000f),
-		color(0.500000f, 0.276308f, 0.000000f),
-		color(0.482561f, 0.266269f, 0.000000f),
-		color(0.465141f, 0.256303f, 0.000000f),
-		color(0.447759f, 0.246419f, 0.000000f),
-		color(0.430434f, 0.236624f, 0.000000f),
-		color(0.413184f, 0.226927f, 0.000000f),
-		color(0.396028f, 0.217334f, 0.000000f),
-		color(0.378985f, 0.207855f, 0.000000f),
-		color(0.362075f, 0.198496f, 0.000000f),
-		color(0.345316f, 0.189266f, 0.000000f),
-		color(0.328726f, 0.180172f, 0.000000f),
-		color(0.312325f, 0.171222f, 0.000000f),
-		color(0.296131f, 0.162425f, 0.000000f),
-		color(0.280164f, 0.153787f, 0.000000f),
-		color(0.264442f, 0.145317f, 0.000000f),
-		color(0.248984f, 0.137023f, 0.000000f),
-		color(0.233810f, 0.128912f, 0.000000f),
-		color(0.218937f, 0.120992f, 0.000000f),
-		color(0.204385f, 0.113271f, 0.000000f),
-		color(0.190172f, 0.105758f, 0.000000f),
-		color(0.176318f, 0.098458f, 0.000000f),
-		color(0.162841f, 0.091382f, 0.000000f),
-		color(0.149760f, 0.084535f, 0.000000f),
-		color(0.137095f, 0.077927f, 0.000000f),
-		color(0.124863f, 0.071565f, 0.000000f),
-		color(0.113084f, 0.065457f, 0.000000f),
-		color(0.101777f, 0.059610f, 0.000000f),
-		color(0.090961f, 0.054033f, 0.000000f),
-		color(0.080653f, 0.048734f, 0.000000f),
-		color(0.070874f, 0.043719f, 0.000000f),
-		color(0.061642f, 0.038998f, 0.000000f),
-		color(0.052976f, 0.034577f, 0.000000f),
-		color(0.044895f, 0.030465f, 0.000000f),
-		color(0.037418f, 0.026669f, 0.000000f),
-		color(0.030563f, 0.023198f, 0.000000f),
-		color(0.024350f, 0.020059f, 0.000000f),
-		color(0.018797f, 0.017260f, 0.000000f),
-		color(0.013923f, 0.014808f, 0.000000f),
-		color(0.009748f, 0.012713f, 0.000000f),
-		color(0.006289f, 0.010981f, 0.000000f),
-		color(0.003566f, 0.009620f, 0.000000f),
-		color(0.001597f, 0.008638f, 0.000000f),
-		color(0.000402f, 0.008043f, 0.000000f),
-		color(0.000000f, 0.007843f, 0.000000f),
-		color(0.000000f, 0.007802f, 0.000244f),
-		color(0.000000f, 0.007683f, 0.000969f),
-		color(0.000000f, 0.007491f, 0.002160f),
-		color(0.000000f, 0.007231f, 0.003805f),
-		color(0.000000f, 0.006908f, 0.005891f),
-		color(0.000000f, 0.006526f, 0.008403f),
-		color(0.000000f, 0.006092f, 0.011329f),
-		color(0.000000f, 0.005609f, 0.014656f),
-		color(0.000000f, 0.005083f, 0.018370f),
-		color(0.000000f, 0.004519f, 0.022458f),
-		color(0.000000f, 0.003922f, 0.026906f),
-		color(0.000000f, 0.003297f, 0.031703f),
-		color(0.000000f, 0.002649f, 0.036833f),
-		color(0.000000f, 0.001983f, 0.042284f),
-		color(0.000000f, 0.001304f, 0.048043f),
-		color(0.000000f, 0.000617f, 0.054097f),
-		color(0.000000f, -0.000073f, 0.060432f),
-		color(0.000000f, -0.000761f, 0.067034f),
-		color(0.000000f, -0.001442f, 0.073892f),
-		color(0.000000f, -0.002110f, 0.080990f),
-		color(0.000000f, -0.002762f, 0.088317f),
-		color(0.000000f, -0.003392f, 0.095859f),
-		color(0.000000f, -0.003994f, 0.103602f),
-		color(0.000000f, -0.004565f, 0.111534f),
-		color(0.000000f, -0.005098f, 0.119641f),
-		color(0.000000f, -0.005589f, 0.127909f),
-		color(0.000000f, -0.006033f, 0.136327f),
-		color(0.000000f, -0.006425f, 0.144879f),
-		color(0.000000f, -0.006759f, 0.153554f),
-		color(0.000000f, -0.007032f, 0.162337f),
-		color(0.000000f, -0.007237f, 0.171216f),
-		color(0.000000f, -0.007370f, 0.180177f),
-		color(0.000000f, -0.007425f, 0.189207f),
-		color(0.000000f, -0.007399f, 0.198293f),
-		color(0.000000f, -0.007285f, 0.207422f),
-		color(0.000000f, -0.007078f, 0.216579f),
-		color(0.000000f, -0.006775f, 0.225753f),
-		color(0.000000f, -0.006369f, 0.234929f),
-		color(0.000000f, -0.005856f, 0.244095f),
-		color(0.000000f, -0.005230f, 0.253237f),
-		color(0.000000f, -0.004488f, 0.262342f),
-		color(0.000000f, -0.003622f, 0.271396f),
-		color(0.000000f, -0.002630f, 0.280387f),
-		color(0.000000f, -0.001505f, 0.289301f),
-		color(0.000000f, -0.000242f, 0.298125f),
-		color(0.000000f, 0.001163f, 0.306846f),
-		color(0.000000f, 0.002715f, 0.315450f),
-		color(0.000000f, 0.004420f, 0.323924f),
-		color(0.000000f, 0.006282f, 0.332255f),
-		color(0.000000f, 0.008307f, 0.340429f),
-		color(0.000000f, 0.010499f, 0.348434f),
-		color(0.000000f, 0.012864f, 0.356256f),
-		color(0.000000f, 0.015406f, 0.363882f),
-		color(0.000000f, 0.018131f, 0.371298f),
-		color(0.000000f, 0.021043f, 0.378491f),
-		color(0.000000f, 0.024148f, 0.385449f)
-	},
-	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383, 384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399 }
-);
\ No newline at end of file
+const Gradient &uf_default()
+{
+	static const Gradient gradient(
+		400,
+		{
+			color(0.000000f, 0.027451f, 0.392157f),
+			color(0.000006f, 0.030944f, 0.398769f),
+			color(0.000025f, 0.034613f, 0.405445f),
+			color(0.000060f, 0.038454f, 0.412182f),
+			color(0.000113f, 0.042462f, 0.418975f),
+			color(0.000186f, 0.046633f, 0.425821f),
+			color(0.000282f, 0.050963f, 0.432717f),
+			color(0.000403f, 0.055447f, 0.439660f),
+			color(0.000551f, 0.060080f, 0.446644f),
+			color(0.000730f, 0.064858f, 0.453668f),
+			color(0.000940f, 0.069776f, 0.460727f),
+			color(0.001185f, 0.074831f, 0.467818f),
+			color(0.001467f, 0.080017f, 0.474938f),
+			color(0.001789f, 0.085329f, 0.482082f),
+			color(0.002151f, 0.090765f, 0.489247f),
+			color(0.002558f, 0.096319f, 0.496430f),
+			color(0.003011f, 0.101986f, 0.503628f),
+			color(0.003513f, 0.107762f, 0.510836f),
+			color(0.004066f, 0.113643f, 0.518050f),
+			color(0.004672f, 0.119623f, 0.525269f),
+			color(0.005334f, 0.125700f, 0.532487f),
+			color(0.006054f, 0.131867f, 0.539701f),
+			color(0.006835f, 0.138122f, 0.546909f),
+			color(0.007678f, 0.144458f, 0.554106f),
+			color(0.008587f, 0.150872f, 0.561288f),
+			color(0.009563f, 0.157359f, 0.568452f),
+			color(0.010610f, 0.163915f, 0.575596f),
+			color(0.011728f, 0.170535f, 0.582714f),
+			color(0.012921f, 0.177215f, 0.589803f),
+			color(0.014191f, 0.183950f, 0.596861f),
+			color(0.015541f, 0.190736f, 0.603883f),
+			color(0.016972f, 0.197568f, 0.610866f),
+			color(0.018487f, 0.204442f, 0.617806f),
+			color(0.020089f, 0.211353f, 0.624700f),
+			color(0.021780f, 0.218297f, 0.631544f),
+			color(0.023561f, 0.225269f, 0.638335f),
+			color(0.025437f, 0.232265f, 0.645068f),
+			color(0.027408f, 0.239280f, 0.651742f),
+			color(0.029477f, 0.246310f, 0.658351f),
+			color(0.031647f, 0.253351f, 0.664893f),
+			color(0.033920f, 0.260397f, 0.671363f),
+			color(0.036298f, 0.267445f, 0.677759f),
+			color(0.038784f, 0.274490f, 0.684077f),
+			color(0.041380f, 0.281527f, 0.690312f),
+			color(0.044088f, 0.288552f, 0.696463f),
+			color(0.046911f, 0.295560f, 0.702524f),
+			color(0.049851f, 0.302548f, 0.708493f),
+			color(0.052911f, 0.309510f, 0.714367f),
+			color(0.056092f, 0.316442f, 0.720140f),
+			color(0.059398f, 0.323339f, 0.725811f),
+			color(0.062830f, 0.330197f, 0.731374f),
+			color(0.066391f, 0.337012f, 0.736828f),
+			color(0.070084f, 0.343779f, 0.742168f),
+			color(0.073910f, 0.350494f, 0.747390f),
+			color(0.077872f, 0.357151f, 0.752492f),
+			color(0.081972f, 0.363747f, 0.757469f),
+			color(0.086213f, 0.370277f, 0.762318f),
+			color(0.090597f, 0.376737f, 0.767036f),
+			color(0.095127f, 0.383122f, 0.771619f),
+			color(0.099804f, 0.389428f, 0.776062f),
+			color(0.104632f, 0.395649f, 0.780364f),
+			color(0.109612f, 0.401783f, 0.784520f),
+			color(0.114747f, 0.407823f, 0.788527f),
+			color(0.120039f, 0.413766f, 0.792381f),
+			color(0.125490f, 0.419608f, 0.796078f),
+			color(0.131095f, 0.425446f, 0.799683f),
+			color(0.136843f, 0.431380f, 0.803262f),
+			color(0.142731f, 0.437408f, 0.806815f),
+			color(0.148755f, 0.443526f, 0.810341f),
+			color(0.154914f, 0.449732f, 0.813840f),
+			color(0.161205f, 0.456022f, 0.817312f),
+			color(0.167623f, 0.462393f, 0.820758f),
+			color(0.174166f, 0.468843f, 0.824176f),
+			color(0.180831f, 0.475369f, 0.827567f),
+			color(0.187616f, 0.481966f, 0.830930f),
+			color(0.194516f, 0.488634f, 0.834265f),
+			color(0.201530f, 0.495368f, 0.837573f),
+			color(0.208654f, 0.502165f, 0.840852f),
+			color(0.215885f, 0.509023f, 0.844104f),
+			color(0.223220f, 0.515939f, 0.847326f),
+			color(0.230656f, 0.522909f, 0.850521f),
+			color(0.238190f, 0.529930f, 0.853686f),
+			color(0.245820f, 0.537001f, 0.856823f),
+			color(0.253542f, 0.544117f, 0.859931f),
+			color(0.261352f, 0.551276f, 0.863009f),
+			color(0.269249f, 0.558474f, 0.866058f),
+			color(0.277230f, 0.565710f, 0.869077f),
+			color(0.285290f, 0.572978f, 0.872067f),
+			color(0.293428f, 0.580278f, 0.875027f),
+			color(0.301639f, 0.587606f, 0.877957f),
+			color(0.309922f, 0.594958f, 0.880856f),
+			color(0.318273f, 0.602332f, 0.883725f),
+			color(0.326690f, 0.609725f, 0.886564f),
+			color(0.335168f, 0.617134f, 0.889371f),
+			color(0.343706f, 0.624556f, 0.892148f),
+			color(0.352300f, 0.631987f, 0.894894f),
+			color(0.360948f, 0.639426f, 0.897608f),
+			color(0.369645f, 0.646868f, 0.900291f),
+			color(0.378390f, 0.654312f, 0.902943f),
+			color(0.387179f, 0.661753f, 0.905562f),
+			color(0.396010f, 0.669190f, 0.908150f),
+			color(0.404878f, 0.676618f, 0.910706f),
+			color(0.413782f, 0.684036f, 0.913229f),
+			color(0.422718f, 0.691439f, 0.915720f),
+			color(0.431684f, 0.698826f, 0.918179f),
+			color(0.440676f, 0.706192f, 0.920604f),
+			color(0.449691f, 0.713536f, 0.922997f),
+			color(0.458726f, 0.720854f, 0.925356f),
+			color(0.467779f, 0.728143f, 0.927683f),
+			color(0.476846f, 0.735401f, 0.929975f),
+			color(0.485924f, 0.742623f, 0.932235f),
+			color(0.495011f, 0.749808f, 0.934460f),
+			color(0.504103f, 0.756952f, 0.936652f),
+			color(0.513198f, 0.764052f, 0.938809f),
+			color(0.522291f, 0.771106f, 0.940932f),
+			color(0.531381f, 0.778110f, 0.943021f),
+			color(0.540465f, 0.785061f, 0.945075f),
+			color(0.549539f, 0.791956f, 0.947094f),
+			color(0.558600f, 0.798793f, 0.949078f),
+			color(0.567646f, 0.805568f, 0.951027f),
+			color(0.576673f, 0.812279f, 0.952941f),
+			color(0.585678f, 0.818922f, 0.954820f),
+			color(0.594659f, 0.825494f, 0.956662f),
+			color(0.603612f, 0.831993f, 0.958469f),
+			color(0.612535f, 0.838416f, 0.960240f),
+			color(0.621424f, 0.844758f, 0.961975f),
+			color(0.630277f, 0.851019f, 0.963674f),
+			color(0.639090f, 0.857194f, 0.965336f),
+			color(0.647860f, 0.863280f, 0.966961f),
+			color(0.656585f, 0.869275f, 0.968550f),
+			color(0.665261f, 0.875176f, 0.970101f),
+			color(0.673886f, 0.880979f, 0.971616f),
+			color(0.682456f, 0.886682f, 0.973093f),
+			color(0.690969f, 0.892282f, 0.974533f),
+			color(0.699421f, 0.897775f, 0.975935f),
+			color(0.707810f, 0.903159f, 0.977299f),
+			color(0.716132f, 0.908430f, 0.978625f),
+			color(0.724385f, 0.913587f, 0.979913f),
+			color(0.732565f, 0.918625f, 0.981163f),
+			color(0.740669f, 0.923542f, 0.982374f),
+			color(0.748696f, 0.928334f, 0.983547f),
+			color(0.756640f, 0.933000f, 0.984681f),
+			color(0.764501f, 0.937535f, 0.985776f),
+			color(0.772273f, 0.941937f, 0.986831f),
+			color(0.779956f, 0.946203f, 0.987847f),
+			color(0.787545f, 0.950330f, 0.988824f),
+			color(0.795037f, 0.954315f, 0.989761f),
+			color(0.802430f, 0.958155f, 0.990659f),
+			color(0.809721f, 0.961846f, 0.991516f),
+			color(0.816906f, 0.965387f, 0.992333f),
+			color(0.823983f, 0.968774f, 0.993110f),
+			color(0.830948f, 0.972003f, 0.993846f),
+			color(0.837799f, 0.975073f, 0.994541f),
+			color(0.844532f, 0.977980f, 0.995196f),
+			color(0.851146f, 0.980721f, 0.995810f),
+			color(0.857635f, 0.983292f, 0.996382f),
+			color(0.863999f, 0.985692f, 0.996913f),
+			color(0.870233f, 0.987918f, 0.997403f),
+			color(0.876334f, 0.989965f, 0.997851f),
+			color(0.882301f, 0.991831f, 0.998257f),
+			color(0.888129f, 0.993514f, 0.998621f),
+			color(0.893815f, 0.995010f, 0.998943f),
+			color(0.899357f, 0.996316f, 0.999222f),
+			color(0.904752f, 0.997429f, 0.999459f),
+			color(0.909997f, 0.998347f, 0.999653f),
+			color(0.915088f, 0.999066f, 0.999805f),
+			color(0.920023f, 0.999583f, 0.999913f),
+			color(0.924798f, 0.999895f, 0.999978f),
+			color(0.929412f, 1.000000f, 1.000000f),
+			color(0.933868f, 0.999938f, 0.999624f),
+			color(0.938177f, 0.999752f, 0.998508f),
+			color(0.942339f, 0.999443f, 0.996668f),
+			color(0.946359f, 0.999014f, 0.994122f),
+			color(0.950237f, 0.998465f, 0.990886f),
+			color(0.953976f, 0.997798f, 0.986978f),
+			color(0.957578f, 0.997014f, 0.982415f),
+			color(0.961046f, 0.996115f, 0.977213f),
+			color(0.964381f, 0.995101f, 0.971390f),
+			color(0.967586f, 0.993975f, 0.964963f),
+			color(0.970663f, 0.992738f, 0.957949f),
+			color(0.973615f, 0.991391f, 0.950364f),
+			color(0.976443f, 0.989935f, 0.942226f),
+			color(0.979150f, 0.988372f, 0.933552f),
+			color(0.981739f, 0.986703f, 0.924358f),
+			color(0.984210f, 0.984930f, 0.914663f),
+			color(0.986567f, 0.983054f, 0.904482f),
+			color(0.988812f, 0.981076f, 0.893834f),
+			color(0.990946f, 0.978998f, 0.882734f),
+			color(0.992973f, 0.976821f, 0.871200f),
+			color(0.994895f, 0.974547f, 0.859249f),
+			color(0.996713f, 0.972176f, 0.846898f),
+			color(0.998429f, 0.969711f, 0.834164f),
+			color(1.000047f, 0.967153f, 0.821064f),
+			color(1.001569f, 0.964502f, 0.807616f),
+			color(1.002996f, 0.961761f, 0.793835f),
+			color(1.004331f, 0.958930f, 0.779739f),
+			color(1.005575f, 0.956012f, 0.765346f),
+			color(1.006733f, 0.953007f, 0.750671f),
+			color(1.007804f, 0.949917f, 0.735733f),
+			color(1.008793f, 0.946744f, 0.720548f),
+			color(1.009700f, 0.943488f, 0.705133f),
+			color(1.010528f, 0.940151f, 0.689505f),
+			color(1.011280f, 0.936735f, 0.673682f),
+			color(1.011958f, 0.933240f, 0.657680f),
+			color(1.012564f, 0.929669f, 0.641516f),
+			color(1.013099f, 0.926022f, 0.625208f),
+			color(1.013567f, 0.922301f, 0.608771f),
+			color(1.013970f, 0.918508f, 0.592225f),
+			color(1.014309f, 0.914643f, 0.575584f),
+			color(1.014588f, 0.910708f, 0.558867f),
+			color(1.014808f, 0.906705f, 0.542091f),
+			color(1.014971f, 0.902635f, 0.525271f),
+			color(1.015080f, 0.898498f, 0.508427f),
+			color(1.015137f, 0.894298f, 0.491573f),
+			color(1.015144f, 0.890034f, 0.474729f),
+			color(1.015104f, 0.885709f, 0.457909f),
+			color(1.015018f, 0.881324f, 0.441133f),
+			color(1.014889f, 0.876879f, 0.424416f),
+			color(1.014720f, 0.872378f, 0.407775f),
+			color(1.014511f, 0.867820f, 0.391229f),
+			color(1.014267f, 0.863207f, 0.374792f),
+			color(1.013988f, 0.858541f, 0.358484f),
+			color(1.013677f, 0.853823f, 0.342320f),
+			color(1.013336f, 0.849054f, 0.326318f),
+			color(1.012968f, 0.844237f, 0.310495f),
+			color(1.012575f, 0.839371f, 0.294867f),
+			color(1.012158f, 0.834459f, 0.279452f),
+			color(1.011721f, 0.829502f, 0.264267f),
+			color(1.011266f, 0.824501f, 0.249329f),
+			color(1.010793f, 0.819457f, 0.234654f),
+			color(1.010307f, 0.814373f, 0.220261f),
+			color(1.009809f, 0.809250f, 0.206165f),
+			color(1.009302f, 0.804088f, 0.192384f),
+			color(1.008786f, 0.798889f, 0.178936f),
+			color(1.008266f, 0.793655f, 0.165836f),
+			color(1.007743f, 0.788387f, 0.153102f),
+			color(1.007219f, 0.783086f, 0.140751f),
+			color(1.006697f, 0.777754f, 0.128800f),
+			color(1.006178f, 0.772392f, 0.117266f),
+			color(1.005665f, 0.767001f, 0.106166f),
+			color(1.005161f, 0.761584f, 0.095518f),
+			color(1.004667f, 0.756140f, 0.085337f),
+			color(1.004185f, 0.750672f, 0.075642f),
+			color(1.003719f, 0.745182f, 0.066448f),
+			color(1.003269f, 0.739669f, 0.057774f),
+			color(1.002839f, 0.734136f, 0.049636f),
+			color(1.002431f, 0.728585f, 0.042051f),
+			color(1.002046f, 0.723016f, 0.035037f),
+			color(1.001687f, 0.717431f, 0.028610f),
+			color(1.001357f, 0.711831f, 0.022787f),
+			color(1.001057f, 0.706217f, 0.017585f),
+			color(1.000790f, 0.700592f, 0.013022f),
+			color(1.000558f, 0.694956f, 0.009114f),
+			color(1.000363f, 0.689311f, 0.005878f),
+			color(1.000208f, 0.683658f, 0.003332f),
+			color(1.000094f, 0.677999f, 0.001492f),
+			color(1.000024f, 0.672335f, 0.000376f),
+			color(1.000000f, 0.666667f, 0.000000f),
+			color(0.999598f, 0.660863f, 0.000000f),
+			color(0.998403f, 0.654797f, 0.000000f),
+			color(0.996434f, 0.648475f, 0.000000f),
+			color(0.993711f, 0.641906f, 0.000000f),
+			color(0.990252f, 0.635098f, 0.000000f),
+			color(0.986077f, 0.628058f, 0.000000f),
+			color(0.981203f, 0.620794f, 0.000000f),
+			color(0.975650f, 0.613314f, 0.000000f),
+			color(0.969437f, 0.605626f, 0.000000f),
+			color(0.962582f, 0.597738f, 0.000000f),
+			color(0.955105f, 0.589658f, 0.000000f),
+			color(0.947024f, 0.581392f, 0.000000f),
+			color(0.938358f, 0.572950f, 0.000000f),
+			color(0.929126f, 0.564339f, 0.000000f),
+			color(0.919347f, 0.555567f, 0.000000f),
+			color(0.909039f, 0.546642f, 0.000000f),
+			color(0.898223f, 0.537570f, 0.000000f),
+			color(0.886916f, 0.528362f, 0.000000f),
+			color(0.875137f, 0.519023f, 0.000000f),
+			color(0.862905f, 0.509563f, 0.000000f),
+			color(0.850240f, 0.499988f, 0.000000f),
+			color(0.837159f, 0.490307f, 0.000000f),
+			color(0.823682f, 0.480528f, 0.000000f),
+			color(0.809828f, 0.470657f, 0.000000f),
+			color(0.795615f, 0.460704f, 0.000000f),
+			color(0.781063f, 0.450676f, 0.000000f),
+			color(0.766190f, 0.440581f, 0.000000f),
+			color(0.751016f, 0.430426f, 0.000000f),
+			color(0.735558f, 0.420220f, 0.000000f),
+			color(0.719836f, 0.409970f, 0.000000f),
+			color(0.703869f, 0.399684f, 0.000000f),
+			color(0.687675f, 0.389371f, 0.000000f),
+			color(0.671274f, 0.379037f, 0.000000f),
+			color(0.654684f, 0.368690f, 0.000000f),
+			color(0.637925f, 0.358339f, 0.000000f),
+			color(0.621015f, 0.347992f, 0.000000f),
+			color(0.603972f, 0.337655f, 0.000000f),
+			color(0.586816f, 0.327338f, 0.000000f),
+			color(0.569566f, 0.317047f, 0.000000f),
+			color(0.552241f, 0.306791f, 0.000000f),
+			color(0.534859f, 0.296577f, 0.000000f),
+			color(0.517439f, 0.286414f, 0.000000f),
+			color(0.500000f, 0.276308f, 0.000000f),
+			color(0.482561f, 0.266269f, 0.000000f),
+			color(0.465141f, 0.256303f, 0.000000f),
+			color(0.447759f, 0.246419f, 0.000000f),
+			color(0.430434f, 0.236624f, 0.000000f),
+			color(0.413184f, 0.226927f, 0.000000f),
+			color(0.396028f, 0.217334f, 0.000000f),
+			color(0.378985f, 0.207855f, 0.000000f),
+			color(0.362075f, 0.198496f, 0.000000f),
+			color(0.345316f, 0.189266f, 0.000000f),
+			color(0.328726f, 0.180172f, 0.000000f),
+			color(0.312325f, 0.171222f, 0.000000f),
+			color(0.296131f, 0.162425f, 0.000000f),
+			color(0.280164f, 0.153787f, 0.000000f),
+			color(0.264442f, 0.145317f, 0.000000f),
+			color(0.248984f, 0.137023f, 0.000000f),
+			color(0.233810f, 0.128912f, 0.000000f),
+			color(0.218937f, 0.120992f, 0.000000f),
+			color(0.204385f, 0.113271f, 0.000000f),
+			color(0.190172f, 0.105758f, 0.000000f),
+			color(0.176318f, 0.098458f, 0.000000f),
+			color(0.162841f, 0.091382f, 0.000000f),
+			color(0.149760f, 0.084535f, 0.000000f),
+			color(0.137095f, 0.077927f, 0.000000f),
+			color(0.124863f, 0.071565f, 0.000000f),
+			color(0.113084f, 0.065457f, 0.000000f),
+			color(0.101777f, 0.059610f, 0.000000f),
+			color(0.090961f, 0.054033f, 0.000000f),
+			color(0.080653f, 0.048734f, 0.000000f),
+			color(0.070874f, 0.043719f, 0.000000f),
+			color(0.061642f, 0.038998f, 0.000000f),
+			color(0.052976f, 0.034577f, 0.000000f),
+			color(0.044895f, 0.030465f, 0.000000f),
+			color(0.037418f, 0.026669f, 0.000000f),
+			color(0.030563f, 0.023198f, 0.000000f),
+			color(0.024350f, 0.020059f, 0.000000f),
+			color(0.018797f, 0.017260f, 0.000000f),
+			color(0.013923f, 0.014808f, 0.000000f),
+			color(0.009748f, 0.012713f, 0.000000f),
+			color(0.006289f, 0.010981f, 0.000000f),
+			color(0.003566f, 0.009620f, 0.000000f),
+			color(0.001597f, 0.008638f, 0.000000f),
+			color(0.000402f, 0.008043f, 0.000000f),
+			color(0.000000f, 0.007843f, 0.000000f),
+			color(0.000000f, 0.007802f, 0.000244f),
+			color(0.000000f, 0.007683f, 0.000969f),
+			color(0.000000f, 0.007491f, 0.002160f),
+			color(0.000000f, 0.007231f, 0.003805f),
+			color(0.000000f, 0.006908f, 0.005891f),
+			color(0.000000f, 0.006526f, 0.008403f),
+			color(0.000000f, 0.006092f, 0.011329f),
+			color(0.000000f, 0.005609f, 0.014656f),
+			color(0.000000f, 0.005083f, 0.018370f),
+			color(0.000000f, 0.004519f, 0.022458f),
+			color(0.000000f, 0.003922f, 0.026906f),
+			color(0.000000f, 0.003297f, 0.031703f),
+			color(0.000000f, 0.002649f, 0.036833f),
+			color(0.000000f, 0.001983f, 0.042284f),
+			color(0.000000f, 0.001304f, 0.048043f),
+			color(0.000000f, 0.000617f, 0.054097f),
+			color(0.000000f, -0.000073f, 0.060432f),
+			color(0.000000f, -0.000761f, 0.067034f),
+			color(0.000000f, -0.001442f, 0.073892f),
+			color(0.000000f, -0.002110f, 0.080990f),
+			color(0.000000f, -0.002762f, 0.088317f),
+			color(0.000000f, -0.003392f, 0.095859f),
+			color(0.000000f, -0.003994f, 0.103602f),
+			color(0.000000f, -0.004565f, 0.111534f),
+			color(0.000000f, -0.005098f, 0.119641f),
+			color(0.000000f, -0.005589f, 0.127909f),
+			color(0.000000f, -0.006033f, 0.136327f),
+			color(0.000000f, -0.006425f, 0.144879f),
+			color(0.000000f, -0.006759f, 0.153554f),
+			color(0.000000f, -0.007032f, 0.162337f),
+			color(0.000000f, -0.007237f, 0.171216f),
+			color(0.000000f, -0.007370f, 0.180177f),
+			color(0.000000f, -0.007425f, 0.189207f),
+			color(0.000000f, -0.007399f, 0.198293f),
+			color(0.000000f, -0.007285f, 0.207422f),
+			color(0.000000f, -0.007078f, 0.216579f),
+			color(0.000000f, -0.006775f, 0.225753f),
+			color(0.000000f, -0.006369f, 0.234929f),
+			color(0.000000f, -0.005856f, 0.244095f),
+			color(0.000000f, -0.005230f, 0.253237f),
+			color(0.000000f, -0.004488f, 0.262342f),
+			color(0.000000f, -0.003622f, 0.271396f),
+			color(0.000000f, -0.002630f, 0.280387f),
+			color(0.000000f, -0.001505f, 0.289301f),
+			color(0.000000f, -0.000242f, 0.298125f),
+			color(0.000000f, 0.001163f, 0.306846f),
+			color(0.000000f, 0.002715f, 0.315450f),
+			color(0.000000f, 0.004420f, 0.323924f),
+			color(0.000000f, 0.006282f, 0.332255f),
+			color(0.000000f, 0.008307f, 0.340429f),
+			color(0.000000f, 0.010499f, 0.348434f),
+			color(0.000000f, 0.012864f, 0.356256f),
+			color(0.000000f, 0.015406f, 0.363882f),
+			color(0.000000f, 0.018131f, 0.371298f),
+			color(0.000000f, 0.021043f, 0.378491f),
+			color(0.000000f, 0.024148f, 0.385449f)
+		},
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383, 384, 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399 }
+	);
+	return gradient;
+}
+
+// gradient of the library by name, nullptr if there is none
+const Gradient *getGradient(const std::string &name)
+{
+	if (name == "CBR_coldhot")
+		return &CBR_coldhot();
+	else if (name == "jet")
+		return &jet();
+	else if (name == "standard_muted")
+		return &standard_muted();
+	else if (name == "volcano_under_a_glacier")
+		return &volcano_under_a_glacier();
+	else if (name == "uf_default")
+		return &uf_default();
+	else
+		return nullptr;
+}
@@ -0,0 +1,342 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Gradient.h"
+
+/* Gradient files
+
+   Reads Fractint palettes (.map: one "r g b" line per entry with values in
+   0..255, anything after the third number is a comment) and Ultra Fractal
+   gradient collections (.ugr: any number of "name { gradient: ... }"
+   entries whose gradient section lists "index=i color=c" stops, c is
+   0xBBGGRR and i is taken modulo 400, UF's gradient length). A .map file
+   gives one gradient named after the file, a .ugr file one per entry.
+
+   Parsing and baking a library of thousands of palettes at startup adds
+   up, so loadGradients() can go through a gradientCache: a memory mapped
+   file of baked tables keyed by a hash of the gradient file's contents. A
+   file whose contents are in the cache is neither parsed nor baked, its
+   gradients are copied from the mapped tables. Gradients of new files are
+   appended to the cache file, which is read-only otherwise and can be
+   shared between processes. */
+
+struct namedGradient
+{
+	std::string name;
+	Gradient gradient;
+};
+
+// 64 bit FNV-1a
+inline uint64_t gradientFileHash(const std::string &contents)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (const char c : contents)
+	{
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+inline bool isGradientFile(const std::string &name)
+{
+	const auto hasExtension = [&name](const char *extension)
+	{
+		const size_t n = std::strlen(extension);
+		return name.size() > n && name.compare(name.size() - n, n, extension) == 0;
+	};
+	return hasExtension(".map") || hasExtension(".ugr");
+}
+
+// stops of a .map file, false if it has no entries
+inline bool parseMapFile(const std::string &contents, std::vector<color> &colors, std::vector<int> &indices)
+{
+	std::istringstream lines(contents);
+	std::string line;
+	while (std::getline(lines, line))
+	{
+		std::istringstream values(line);
+		int r, g, b;
+		if (!(values >> r >> g >> b))
+			continue;
+		indices.push_back(indices.size());
+		colors.push_back(color(r / 255.f, g / 255.f, b / 255.f));
+	}
+	return !colors.empty();
+}
+
+// gradients of a .ugr file, entries without stops are skipped
+inline std::vector<namedGradient> parseUgrFile(const std::string &contents)
+{
+	constexpr int ugrLength = 400;
+	std::vector<namedGradient> gradients;
+	std::istringstream lines(contents);
+	std::string line, name;
+	bool inEntry = false, inGradient = false;
+	std::map<int, color> stops; // sorted by index, the first stop at an index wins
+	while (std::getline(lines, line))
+	{
+		const size_t open = line.find('{');
+		if (!inEntry && open != std::string::npos)
+		{
+			name = line.substr(0, open);
+			name.erase(name.find_last_not_of(" \t\r") + 1);
+			name.erase(0, name.find_first_not_of(" \t"));
+			inEntry = true;
+			inGradient = false;
+			stops.clear();
+			continue;
+		}
+		if (!inEntry)
+			continue;
+		std::istringstream tokens(line);
+		std::string token;
+		int index = 0;
+		bool hasIndex = false;
+		while (tokens >> token)
+		{
+			if (token == "}")
+			{
+				inEntry = false;
+				break;
+			}
+			if (token.back() == ':')
+			{
+				inGradient = token == "gradient:";
+				continue;
+			}
+			const size_t equals = token.find('=');
+			if (!inGradient || equals == std::string::npos)
+				continue;
+			const std::string key = token.substr(0, equals);
+			const std::string value = token.substr(equals + 1);
+			if (key == "index")
+			{
+				index = ((std::atoi(value.c_str()) % ugrLength) + ugrLength) % ugrLength;
+				hasIndex = true;
+			}
+			else if (key == "color" && hasIndex)
+			{
+				const long c = std::atol(value.c_str());
+				stops.emplace(index, color((c & 255) / 255.f, ((c >> 8) & 255) / 255.f, ((c >> 16) & 255) / 255.f));
+				hasIndex = false;
+			}
+		}
+		if (!inEntry && !stops.empty())
+		{
+			std::vector<color> colors;
+			std::vector<int> indices;
+			for (const auto &stop : stops)
+			{
+				indices.push_back(stop.first);
+				colors.push_back(stop.second);
+			}
+			gradients.push_back({name, Gradient(ugrLength, colors, indices)});
+		}
+	}
+	return gradients;
+}
+
+struct gradientCacheRecord
+{
+	uint64_t key; // hash of the gradient file
+	int32_t count; // gradients of the file, its records follow each other
+	int32_t length;
+	int32_t lutBits;
+	char name[68]; // 88 bytes without padding
+	// followed by the r, g and b tables, 2^lutBits + 1 floats each
+};
+
+class gradientCache
+{
+private:
+	int fd = -1;
+	size_t mappedSize = 0;
+	void *mapped = nullptr;
+	std::map<uint64_t, size_t> firstRecord; // offset of the first record per key
+	static constexpr char magicString[8] = {'M', 'B', 'G', 'R', 'A', 'D', '1', '\0'};
+
+	static size_t recordSize(const int lutBits) { return sizeof(gradientCacheRecord) + 3 * sizeof(float) * ((1 << lutBits) + 1); }
+
+	// indexes the records in the mapping, false if it is not a complete cache file
+	bool index()
+	{
+		const char *data = (const char*)mapped;
+		if (mappedSize < sizeof(magicString) || std::memcmp(data, magicString, sizeof(magicString)) != 0)
+			return false;
+		size_t offset = sizeof(magicString);
+		while (offset < mappedSize)
+		{
+			gradientCacheRecord record;
+			if (mappedSize - offset < sizeof(record))
+				return false;
+			std::memcpy(&record, data + offset, sizeof(record));
+			if (record.lutBits < 1 || record.lutBits > 16 || mappedSize - offset < recordSize(record.lutBits))
+				return false;
+			firstRecord.emplace(record.key, offset);
+			offset += recordSize(record.lutBits);
+		}
+		return true;
+	}
+
+public:
+	gradientCache() {}
+	gradientCache(const gradientCache&) = delete;
+	gradientCache& operator=(const gradientCache&) = delete;
+	~gradientCache() { close(); }
+
+	// open the cache file at path, an empty one is created if there is none
+	bool open(const std::string &path)
+	{
+		close();
+		fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+		if (fd < 0)
+			return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0)
+		{
+			close();
+			return false;
+		}
+		if (info.st_size == 0)
+			return write(fd, magicString, sizeof(magicString)) == (ssize_t)sizeof(magicString);
+		mappedSize = info.st_size;
+		mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+		if (mapped == MAP_FAILED)
+		{
+			mapped = nullptr;
+			close();
+			return false;
+		}
+		if (!index())
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void close()
+	{
+		if (mapped != nullptr)
+			munmap(mapped, mappedSize);
+		if (fd >= 0)
+			::close(fd);
+		mapped = nullptr;
+		mappedSize = 0;
+		firstRecord.clear();
+		fd = -1;
+	}
+
+	bool isOpen() const { return fd >= 0; }
+
+	// the gradients of the file with hash key, false if they are not cached
+	bool find(const uint64_t key, std::vector<namedGradient> &gradients) const
+	{
+		const auto it = firstRecord.find(key);
+		if (it == firstRecord.end())
+			return false;
+		const char *data = (const char*)mapped;
+		size_t offset = it->second;
+		gradientCacheRecord record;
+		std::memcpy(&record, data + offset, sizeof(record));
+		const int count = record.count;
+		std::vector<namedGradient> found;
+		for (int ii = 0; ii < count; ii++)
+		{
+			// index() checked that all records are complete
+			if (offset >= mappedSize)
+				return false;
+			std::memcpy(&record, data + offset, sizeof(record));
+			if (record.key != key)
+				return false;
+			const int entries = (1 << record.lutBits) + 1;
+			const float *table = (const float*)(data + offset + sizeof(record));
+			record.name[sizeof(record.name) - 1] = '\0';
+			found.push_back({record.name,
+				Gradient(record.length, record.lutBits, table, table + entries, table + 2*entries)});
+			offset += recordSize(record.lutBits);
+		}
+		gradients.insert(gradients.end(), found.begin(), found.end());
+		return true;
+	}
+
+	// appends the gradients of the file with hash key, they are found after
+	// the cache is opened again
+	bool store(const uint64_t key, const std::vector<namedGradient> &gradients)
+	{
+		if (fd < 0)
+			return false;
+		std::vector<char> records;
+		for (const namedGradient &g : gradients)
+		{
+			gradientCacheRecord record = {};
+			record.key = key;
+			record.count = gradients.size();
+			record.length = g.gradient.get_length();
+			record.lutBits = g.gradient.table_bits();
+			std::strncpy(record.name, g.name.c_str(), sizeof(record.name) - 1);
+			const size_t tableSize = sizeof(float) * ((1 << record.lutBits) + 1);
+			const size_t offset = records.size();
+			records.resize(offset + recordSize(record.lutBits));
+			std::memcpy(records.data() + offset, &record, sizeof(record));
+			for (int channel = 0; channel < 3; channel++)
+				std::memcpy(records.data() + offset + sizeof(record) + channel*tableSize, g.gradient.table(channel), tableSize);
+		}
+		// one write, so that concurrent appends do not interleave records
+		return write(fd, records.data(), records.size()) == (ssize_t)records.size();
+	}
+};
+
+// gradients of the .map or .ugr file at path, empty (after saying why) if
+// there are none; cache is used if it is open
+inline std::vector<namedGradient> loadGradients(const std::string &path, gradientCache *cache = nullptr)
+{
+	std::vector<namedGradient> gradients;
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not open gradient file " << path << "\n";
+		return gradients;
+	}
+	std::stringstream contents;
+	contents << file.rdbuf();
+	const std::string text = contents.str();
+	const uint64_t key = gradientFileHash(text);
+	if (cache != nullptr && cache->isOpen() && cache->find(key, gradients))
+		return gradients;
+	if (path.size() > 4 && path.compare(path.size() - 4, 4, ".map") == 0)
+	{
+		std::vector<color> colors;
+		std::vector<int> indices;
+		if (parseMapFile(text, colors, indices))
+		{
+			const size_t slash = path.find_last_of('/');
+			const std::string name = path.substr((slash == std::string::npos) ? 0 : slash + 1);
+			gradients.push_back({name.substr(0, name.size() - 4), Gradient(colors.size(), colors, indices)});
+		}
+	}
+	else
+		gradients = parseUgrFile(text);
+	if (gradients.empty())
+	{
+		std::cout << "No gradients in " << path << "\n";
+		return gradients;
+	}
+	if (cache != nullptr && cache->isOpen() && !cache->store(key, gradients))
+		std::cout << "Could not add " << path << " to the gradient cache\n";
+	return gradients;
+}
@@ -0,0 +1,262 @@
+#pragma once
+#include <array>
+#include <utility>
+
+#include "Complex.h"
+
+/* Compile time iteration kernels
+
+   Instead of calling start/iterate/bailoutCheck through the abstract base
+   class for every iteration, every formula provides an orbit() method that
+   is instantiated with the concrete formula type. The renderer asks the
+   fractal for its kernel once per render and then only makes one indirect
+   call per batch of samples. */
+
+class abstractBaseFractal;
+
+// answer of a bailout check: keep going, the orbit escaped, or it is provably
+// inside (no need to iterate up to maxIter)
+enum class bailoutState { iterating, escaped, inside };
+
+// what is left of an orbit after iterating it
+struct orbitResult
+{
+	complex z; // last value of z
+	int iter; // number of iterations done
+	bool bailedOut;
+	bool inside = false; // stopped early because the point is known to be inside
+};
+
+// what the quadratic (z^2 + c) kernels need to know about a formula, the
+// power kernels (z^N + c) use the same settings without the cardioid test
+struct quadraticSettings
+{
+	int maxIter;
+	double bailout;
+	double periodicityTolerance = 0; // 0 disables cycle detection
+	bool cardioidTest = false; // reject the Mandelbrot main cardioid and period 2 bulb up front
+	complex trapCenter = complex(0); // orbits entering |z - trapCenter| < trapRadius are inside
+	double trapRadius = 0; // 0 disables the trap (see AttractingCycle.h)
+};
+
+// iterates a batch of n samples with starting points z0 and stores the results
+using orbitKernel = void (*)(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n);
+// continues a batch of n samples that stopped at iteration iterFrom with values zFrom
+// (samples that hit an earlier, lower maxIter, see GBuffer.h)
+using resumeKernel = void (*)(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n);
+
+template <class Formula>
+void orbitBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	for (int ii = 0; ii < n; ii++)
+		results[ii] = formula.orbit(z0[ii]);
+}
+
+template <class Formula>
+void resumeBatch(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	for (int ii = 0; ii < n; ii++)
+		results[ii] = formula.resume(z0[ii], zFrom[ii], iterFrom);
+}
+
+// orbits that remember more than z (see genericOrbit) can not go on from the
+// stored z, continued samples are iterated again from the start instead
+template <class Formula>
+void restartBatch(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+{
+	orbitBatch<Formula>(fractal, z0, results, n);
+}
+
+// generic loop from an orbit's state after iter iterations, Formula is the
+// concrete (final) class so all calls get inlined; formulas are immutable
+// during a render and shared by all threads, everything an orbit changes
+// lives in the formula's orbitState on the stack of the loop
+template <class Formula>
+inline orbitResult genericOrbit(const Formula &formula, const complex &z0, const int maxIter,
+	typename Formula::orbitState state, int iter)
+{
+	bailoutState bailout = bailoutState::iterating;
+	while (bailout == bailoutState::iterating && iter < maxIter)
+	{
+		formula.iterate(state, z0);
+		iter++;
+		bailout = formula.bailoutCheck(state.z, iter);
+	}
+	return {state.z, iter, bailout == bailoutState::escaped, bailout == bailoutState::inside};
+}
+
+template <class Formula>
+inline orbitResult genericOrbit(const Formula &formula, const complex &z0, const int maxIter)
+{
+	typename Formula::orbitState state;
+	formula.start(state, z0);
+	return genericOrbit(formula, z0, maxIter, state, 0);
+}
+
+// settings for continuing quadratic orbits that stopped after iterFrom iterations,
+// the kernels count from 0 so the remaining budget is passed and iterFrom added back
+inline quadraticSettings resumedSettings(quadraticSettings settings, const int iterFrom)
+{
+	settings.maxIter -= iterFrom;
+	settings.cardioidTest = false; // cardioid samples never hit maxIter
+	return settings;
+}
+
+inline void addIterations(orbitResult *results, const int n, const int iterFrom)
+{
+	for (int ii = 0; ii < n; ii++)
+		results[ii].iter += iterFrom;
+}
+
+// main cardioid and period 2 bulb of the Mandelbrot set
+inline bool inMainCardioidOrBulb(const complex &c)
+{
+	const double xq = c.x - 0.25;
+	const double y2 = c.y * c.y;
+	const double q = xq * xq + y2;
+	if (q * (q + xq) <= 0.25 * y2)
+		return true;
+	const double xb = c.x + 1;
+	return xb * xb + y2 <= 0.0625;
+}
+
+// z -> z^2 + c with the squares shared between the update and the |z|^2 test
+// periodicityTolerance > 0 enables Brent style cycle detection: z is compared
+// with a saved value that is refreshed after 1, 2, 4, 8, ... iterations, an
+// orbit that comes back to it is cyclic and therefore inside
+// T is double, or doubleDouble / quadDouble for zooms past double resolution,
+// the tests only need the leading double
+template <class T>
+inline orbitResult quadraticOrbit(const complexT<T> &zStart, const complexT<T> &c, const quadraticSettings &settings)
+{
+	const int maxIter = settings.maxIter;
+	const double bailout = settings.bailout;
+	T x = zStart.x;
+	T y = zStart.y;
+	T x2 = x * x;
+	T y2 = y * y;
+	const double tolerance2 = settings.periodicityTolerance * settings.periodicityTolerance;
+	const double trapRadius2 = settings.trapRadius * settings.trapRadius;
+	T savedX = x;
+	T savedY = y;
+	int nextSave = 1;
+	int iter = 0;
+	while (iter < maxIter)
+	{
+		y = 2 * x * y + c.y;
+		x = x2 - y2 + c.x;
+		x2 = x * x;
+		y2 = y * y;
+		iter++;
+		if (toDouble(x2 + y2) >= bailout)
+			return {toComplex(complexT<T>(x, y)), iter, true};
+		if (trapRadius2 > 0)
+		{
+			const double dx = toDouble(x) - settings.trapCenter.x;
+			const double dy = toDouble(y) - settings.trapCenter.y;
+			if (dx * dx + dy * dy < trapRadius2)
+				return {toComplex(complexT<T>(x, y)), iter, false, true};
+		}
+		if (tolerance2 > 0)
+		{
+			const double dx = toDouble(x - savedX);
+			const double dy = toDouble(y - savedY);
+			if (dx * dx + dy * dy < tolerance2)
+				return {toComplex(complexT<T>(x, y)), iter, false, true};
+			if (iter == nextSave)
+			{
+				savedX = x;
+				savedY = y;
+				nextSave *= 2;
+			}
+		}
+	}
+	return {toComplex(complexT<T>(x, y)), iter, false};
+}
+
+// power passed to powerOrbit at run time instead of as a template argument
+constexpr int runtimePower = 0;
+
+// z -> z^N + c, with the same trap and cycle detection as quadraticOrbit;
+// N = runtimePower raises to exponent by square and multiply instead
+template <int N>
+inline orbitResult powerOrbit(const complex &zStart, const complex &c, const int exponent, const quadraticSettings &settings)
+{
+	const double tolerance2 = settings.periodicityTolerance * settings.periodicityTolerance;
+	const double trapRadius2 = settings.trapRadius * settings.trapRadius;
+	complex z = zStart;
+	complex saved = z;
+	int nextSave = 1;
+	int iter = 0;
+	while (iter < settings.maxIter)
+	{
+		if constexpr (N == runtimePower)
+			z = pow(z, exponent) + c;
+		else
+			z = pow<N>(z) + c;
+		iter++;
+		if (z.cabs_squared() >= settings.bailout)
+			return {z, iter, true};
+		if (trapRadius2 > 0 && (z - settings.trapCenter).cabs_squared() < trapRadius2)
+			return {z, iter, false, true};
+		if (tolerance2 > 0)
+		{
+			if ((z - saved).cabs_squared() < tolerance2)
+				return {z, iter, false, true};
+			if (iter == nextSave)
+			{
+				saved = z;
+				nextSave *= 2;
+			}
+		}
+	}
+	return {z, iter, false};
+}
+
+// kernels of formulas with an integer exponent: Formula::orbit<N> and
+// Formula::resume<N> are instantiated for every N up to maxUnrolledPower
+// (Complex.h), powerKernel() picks one per render
+template <class Formula, int N>
+void powerBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	for (int ii = 0; ii < n; ii++)
+		results[ii] = formula.template orbit<N>(z0[ii]);
+}
+
+template <class Formula, int N>
+void powerResumeBatch(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	for (int ii = 0; ii < n; ii++)
+		results[ii] = formula.template resume<N>(z0[ii], zFrom[ii], iterFrom);
+}
+
+// entry N is the kernel for exponent N, entries 0 and 1 go through runtimePower
+template <class Formula, int... N>
+constexpr std::array<orbitKernel, sizeof...(N)> powerKernels(std::integer_sequence<int, N...>)
+{
+	return {{&powerBatch<Formula, (N < 2) ? runtimePower : N>...}};
+}
+
+template <class Formula, int... N>
+constexpr std::array<resumeKernel, sizeof...(N)> powerResumeKernels(std::integer_sequence<int, N...>)
+{
+	return {{&powerResumeBatch<Formula, (N < 2) ? runtimePower : N>...}};
+}
+
+template <class Formula>
+orbitKernel powerKernel(const int exponent)
+{
+	static constexpr auto kernels = powerKernels<Formula>(std::make_integer_sequence<int, maxUnrolledPower + 1>());
+	return (exponent >= 0 && exponent <= maxUnrolledPower) ? kernels[exponent] : &powerBatch<Formula, runtimePower>;
+}
+
+template <class Formula>
+resumeKernel powerContinuation(const int exponent)
+{
+	static constexpr auto kernels = powerResumeKernels<Formula>(std::make_integer_sequence<int, maxUnrolledPower + 1>());
+	return (exponent >= 0 && exponent <= maxUnrolledPower) ? kernels[exponent] : &powerResumeBatch<Formula, runtimePower>;
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <cmath>
+
+/* Double-double and quad-double numbers
+
+   Unevaluated sums of 2 (4) doubles with non overlapping mantissas, giving
+   about 106 (212) bits of precision at hardware speed instead of a bignum
+   library. Everything is built from the error free transforms below: twoSum
+   and twoProd return a rounded result and its exact rounding error (the
+   latter with one fma, compile with -mfma or -march=native so std::fma is an
+   instruction and not a library call). The algorithms follow the QD library
+   (Hida, Li, Bailey), quad-double uses its "sloppy" add and multiply.
+   This breaks under -ffast-math, which is free to reassociate the error terms
+   away. */
+
+// a + b = s + e exactly
+inline double twoSum(const double a, const double b, double &e)
+{
+	const double s = a + b;
+	const double bb = s - a;
+	e = (a - (s - bb)) + (b - bb);
+	return s;
+}
+
+// same for |a| >= |b|
+inline double quickTwoSum(const double a, const double b, double &e)
+{
+	const double s = a + b;
+	e = b - (s - a);
+	return s;
+}
+
+// a * b = p + e exactly
+inline double twoProd(const double a, const double b, double &e)
+{
+	const double p = a * b;
+	e = std::fma(a, b, -p);
+	return p;
+}
+
+struct doubleDouble
+{
+	double hi, lo;
+
+	doubleDouble() {}
+	constexpr doubleDouble(const double x) : hi(x), lo(0) {}
+	constexpr doubleDouble(const double hi_, const double lo_) : hi(hi_), lo(lo_) {}
+
+	doubleDouble operator-() const { return doubleDouble(-hi, -lo); }
+	doubleDouble operator+(const doubleDouble &b) const
+	{
+		double e, f;
+		double s = twoSum(hi, b.hi, e);
+		const double t = twoSum(lo, b.lo, f);
+		e += t;
+		s = quickTwoSum(s, e, e);
+		e += f;
+		s = quickTwoSum(s, e, e);
+		return doubleDouble(s, e);
+	}
+	doubleDouble operator-(const doubleDouble &b) const { return *this + (-b); }
+	doubleDouble operator*(const doubleDouble &b) const
+	{
+		double e;
+		const double p = twoProd(hi, b.hi, e);
+		e += hi * b.lo + lo * b.hi;
+		const double s = quickTwoSum(p, e, e);
+		return doubleDouble(s, e);
+	}
+	doubleDouble operator/(const doubleDouble &b) const
+	{
+		// long division, every quotient digit removes 53 bits of the remainder
+		const double q1 = hi / b.hi;
+		doubleDouble r = *this - b * q1;
+		const double q2 = r.hi / b.hi;
+		r = r - b * q2;
+		const double q3 = r.hi / b.hi;
+		double e;
+		const double s = quickTwoSum(q1, q2, e);
+		return doubleDouble(s, e) + q3;
+	}
+	doubleDouble &operator+=(const doubleDouble &b) { return *this = *this + b; }
+	doubleDouble &operator-=(const doubleDouble &b) { return *this = *this - b; }
+	doubleDouble &operator*=(const doubleDouble &b) { return *this = *this * b; }
+};
+
+struct quadDouble
+{
+	double c[4];
+
+	quadDouble() {}
+	constexpr quadDouble(const double x) : c{x, 0, 0, 0} {}
+	constexpr quadDouble(const double c0, const double c1, const double c2, const double c3) : c{c0, c1, c2, c3} {}
+
+private:
+	static void threeSum(double &a, double &b, double &c)
+	{
+		double t2, t3;
+		const double t1 = twoSum(a, b, t2);
+		a = twoSum(c, t1, t3);
+		b = twoSum(t2, t3, c);
+	}
+	static void threeSum2(double &a, double &b, const double c)
+	{
+		double t2, t3;
+		const double t1 = twoSum(a, b, t2);
+		a = twoSum(c, t1, t3);
+		b = t2 + t3;
+	}
+	// five overlapping components into four non overlapping ones
+	static quadDouble renormalize(double c0, double c1, double c2, double c3, double c4)
+	{
+		double s0, s1, s2 = 0, s3 = 0;
+		s0 = quickTwoSum(c3, c4, c4);
+		s0 = quickTwoSum(c2, s0, c3);
+		s0 = quickTwoSum(c1, s0, c2);
+		c0 = quickTwoSum(c0, s0, c1);
+		s0 = c0;
+		s1 = c1;
+		if (s1 != 0)
+		{
+			s1 = quickTwoSum(s1, c2, s2);
+			if (s2 != 0)
+			{
+				s2 = quickTwoSum(s2, c3, s3);
+				if (s3 != 0)
+					s3 += c4;
+				else
+					s2 = quickTwoSum(s2, c4, s3);
+			}
+			else
+			{
+				s1 = quickTwoSum(s1, c3, s2);
+				if (s2 != 0)
+					s2 = quickTwoSum(s2, c4, s3);
+				else
+					s1 = quickTwoSum(s1, c4, s2);
+			}
+		}
+		else
+		{
+			s0 = quickTwoSum(s0, c2, s1);
+			if (s1 != 0)
+			{
+				s1 = quickTwoSum(s1, c3, s2);
+				if (s2 != 0)
+					s2 = quickTwoSum(s2, c4, s3);
+				else
+					s1 = quickTwoSum(s1, c4, s2);
+			}
+			else
+			{
+				s0 = quickTwoSum(s0, c3, s1);
+				if (s1 != 0)
+					s1 = quickTwoSum(s1, c4, s2);
+				else
+					s0 = quickTwoSum(s0, c4, s1);
+			}
+		}
+		return quadDouble(s0, s1, s2, s3);
+	}
+
+public:
+	quadDouble operator-() const { return quadDouble(-c[0], -c[1], -c[2], -c[3]); }
+	quadDouble operator+(const quadDouble &b) const
+	{
+		double t0, t1, t2, t3;
+		double s0 = twoSum(c[0], b.c[0], t0);
+		double s1 = twoSum(c[1], b.c[1], t1);
+		double s2 = twoSum(c[2], b.c[2], t2);
+		double s3 = twoSum(c[3], b.c[3], t3);
+		s1 = twoSum(s1, t0, t0);
+		threeSum(s2, t0, t1);
+		threeSum2(s3, t0, t2);
+		t0 = t0 + t1 + t3;
+		return renormalize(s0, s1, s2, s3, t0);
+	}
+	quadDouble operator-(const quadDouble &b) const { return *this + (-b); }
+	quadDouble operator*(const quadDouble &b) const
+	{
+		const double *a = c;
+		double q0, q1, q2, q3, q4, q5, t0, t1;
+		double p0 = twoProd(a[0], b.c[0], q0);
+		double p1 = twoProd(a[0], b.c[1], q1);
+		double p2 = twoProd(a[1], b.c[0], q2);
+		double p3 = twoProd(a[0], b.c[2], q3);
+		double p4 = twoProd(a[1], b.c[1], q4);
+		double p5 = twoProd(a[2], b.c[0], q5);
+		threeSum(p1, p2, q0);
+		// six-three sum of p2, q1, q2, p3, p4, p5
+		threeSum(p2, q1, q2);
+		threeSum(p3, p4, p5);
+		double s0 = twoSum(p2, p3, t0);
+		double s1 = twoSum(q1, p4, t1);
+		double s2 = q2 + p5;
+		s1 = twoSum(s1, t0, t0);
+		s2 += t0 + t1;
+		// terms of order eps^3
+		s1 += a[0] * b.c[3] + a[1] * b.c[2] + a[2] * b.c[1] + a[3] * b.c[0] + q0 + q3 + q4 + q5;
+		return renormalize(p0, p1, s0, s1, s2);
+	}
+	quadDouble operator/(const quadDouble &b) const
+	{
+		const double q0 = c[0] / b.c[0];
+		quadDouble r = *this - b * q0;
+		const double q1 = r.c[0] / b.c[0];
+		r = r - b * q1;
+		const double q2 = r.c[0] / b.c[0];
+		r = r - b * q2;
+		const double q3 = r.c[0] / b.c[0];
+		return renormalize(q0, q1, q2, q3, 0);
+	}
+	quadDouble &operator+=(const quadDouble &b) { return *this = *this + b; }
+	quadDouble &operator-=(const quadDouble &b) { return *this = *this - b; }
+	quadDouble &operator*=(const quadDouble &b) { return *this = *this * b; }
+};
+
+// double on the left (e.g. 2 * x * y in complexT::sqr)
+inline doubleDouble operator+(const double a, const doubleDouble &b) { return b + a; }
+inline doubleDouble operator-(const double a, const doubleDouble &b) { return doubleDouble(a) - b; }
+inline doubleDouble operator*(const double a, const doubleDouble &b) { return b * a; }
+inline quadDouble operator+(const double a, const quadDouble &b) { return b + a; }
+inline quadDouble operator-(const double a, const quadDouble &b) { return quadDouble(a) - b; }
+inline quadDouble operator*(const double a, const quadDouble &b) { return b * a; }
+
+// rounding to double, the leading component is the correctly rounded value
+inline double toDouble(const double x) { return x; }
+inline double toDouble(const doubleDouble &x) { return x.hi; }
+inline double toDouble(const quadDouble &x) { return x.c[0]; }
+
+inline doubleDouble abs(const doubleDouble &x) { return (x.hi < 0) ? -x : x; }
+inline quadDouble abs(const quadDouble &x) { return (x.c[0] < 0) ? -x : x; }
+
+// one Newton step on the double square root doubles its precision
+inline doubleDouble sqrt(const doubleDouble &x)
+{
+	if (x.hi <= 0)
+		return doubleDouble(0);
+	const double r = std::sqrt(x.hi);
+	const doubleDouble r2 = doubleDouble(r) * r;
+	return doubleDouble(r) + (x - r2).hi * (0.5 / r);
+}
+inline quadDouble sqrt(const quadDouble &x)
+{
+	if (x.c[0] <= 0)
+		return quadDouble(0);
+	// Newton on 1/sqrt(x): r += r (1 - x r^2) / 2, then sqrt(x) = x r
+	quadDouble r(1. / std::sqrt(x.c[0]));
+	for (int ii = 0; ii < 3; ii++)
+		r = r + r * (quadDouble(1) - x * r * r) * quadDouble(0.5);
+	return x * r;
+}
+
+// how many doubles a scalar is made of
+template <class T> constexpr int scalarComponents() { return sizeof(T) / sizeof(double); }
+
+// cheapest scalar that can still tell neighbouring pixels apart at magnification magn
+enum class precisionLevel { standard, doubleDouble, quadDouble, arbitrary };
+
+inline precisionLevel precisionForMagnification(const double magn)
+{
+	if (magn <= 1e12)
+		return precisionLevel::standard;
+	if (magn <= 1e28)
+		return precisionLevel::doubleDouble;
+	if (magn <= 1e60)
+		return precisionLevel::quadDouble;
+	return precisionLevel::arbitrary;
+}
@@ -0,0 +1,243 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "BigFixed.h"
+#include "BilinearApproximation.h"
+#include "IterationKernel.h"
+
+/* Perturbation for deep zooms of z -> z^2 + c
+
+   Past magn ~1e12 neighbouring pixels round to the same double. Instead, one
+   reference orbit Z is iterated in high precision (BigFixed.h) and rounded to
+   double, and every sample only iterates its difference dz to the reference
+   in double:
+
+       dz -> (2 Z + dz) dz + dc      (dc is the pixel offset, 0 for Julia sets)
+
+   The offsets are tiny but doubles have plenty of exponent range for them.
+   When the full value z = Z + dz gets smaller than dz, the reference no longer
+   describes the sample (a "glitch": dz would lose all its precision to
+   cancellation from here on), the same happens when the reference escapes
+   before the sample. The sample then rebases: it continues with dz = z
+   against an orbit that starts at 0, which is exact since z itself is small
+   (Zhuoran's rebasing, no second pass over glitched pixels is needed).
+   For Mandelbrot sets the reference orbit of the view center starts at 0 and
+   serves both purposes, Julia sets get the critical orbit as second reference.
+   Both orbits come with a BLA table (BilinearApproximation.h) that lets
+   samples skip many iterations at once while their offset is small.
+   Reference orbits are iterated in the cheapest precision that resolves the
+   view: double-double or quad-double up to magn 1e60, BigFixed beyond.
+
+   Up to magn 1e60 the samples can also be iterated directly in double-double
+   or quad-double (deepZoomView::perturbation = false), much slower but free
+   of approximations, e.g. to check perturbation and BLA against. */
+
+// what the deep zoom kernels need to know about the view
+struct deepZoomView
+{
+	bigComplex center;
+	double magn = 1;
+	double maxDelta = 0; // largest offset of a sample from the center
+	bool perturbation = true; // false iterates every sample in double-double / quad-double up to magn 1e60
+};
+
+enum class deepZoomKernel { none, perturbation, doubleDouble, quadDouble };
+
+inline deepZoomKernel deepZoomKernelFor(const deepZoomView &view)
+{
+	const precisionLevel precision = precisionForMagnification(view.magn);
+	if (view.perturbation || precision == precisionLevel::arbitrary)
+		return deepZoomKernel::perturbation;
+	return (precision == precisionLevel::quadDouble) ? deepZoomKernel::quadDouble : deepZoomKernel::doubleDouble;
+}
+
+struct perturbationReference
+{
+	std::vector<complex> orbit; // reference orbit, starting at the view center (Julia) or 0 (Mandelbrot)
+	std::vector<complex> criticalOrbit; // orbit of 0 to rebase to, empty if orbit already starts at 0
+	bool deltaIsParameter = false; // sample offsets are offsets of c (Mandelbrot) or of z (Julia)
+	int startIndex = 0; // index into orbit matching a sample's first z
+	bool useBla = true;
+	blaTable bla; // for orbit
+	blaTable criticalBla; // for criticalOrbit
+	std::shared_ptr<blaCounters> counters = std::make_shared<blaCounters>();
+
+	const std::vector<complex> &rebaseOrbit() const { return (criticalOrbit.empty()) ? orbit : criticalOrbit; }
+	const blaTable &table(const std::vector<complex> *reference) const { return (reference == &criticalOrbit) ? criticalBla : bla; }
+};
+
+// z0, z0^2 + c, ... rounded to double, until it escapes or after maxIter iterations,
+// Z is a complexT or bigComplex
+template <class Z>
+inline std::vector<complex> iterateReference(const Z &z0, const Z &c, const int maxIter, const double bailout)
+{
+	std::vector<complex> orbit;
+	orbit.reserve(maxIter + 1);
+	Z z = z0;
+	orbit.push_back(toComplex(z));
+	for (int ii = 0; ii < maxIter; ii++)
+	{
+		z = z.sqr() + c;
+		orbit.push_back(toComplex(z));
+		if (orbit.back().cabs_squared() >= bailout)
+			break;
+	}
+	return orbit;
+}
+
+inline std::vector<complex> referenceOrbit(const bigComplex &z0, const bigComplex &c, const double magn, const int maxIter, const double bailout)
+{
+	switch (precisionForMagnification(magn))
+	{
+		case precisionLevel::standard:
+			return iterateReference(z0.toComplexT<double>(), c.toComplexT<double>(), maxIter, bailout);
+		case precisionLevel::doubleDouble:
+			return iterateReference(z0.toComplexT<doubleDouble>(), c.toComplexT<doubleDouble>(), maxIter, bailout);
+		case precisionLevel::quadDouble:
+			return iterateReference(z0.toComplexT<quadDouble>(), c.toComplexT<quadDouble>(), maxIter, bailout);
+		default:
+			return iterateReference(z0, c, maxIter, bailout);
+	}
+}
+
+// the Mandelbrot samples start at z = c, which is Z[1] of the orbit of 0
+inline perturbationReference mandelbrotReference(const deepZoomView &view, const int maxIter, const double bailout)
+{
+	perturbationReference reference;
+	const int fracLimbs = view.center.x.precisionBits() / 32;
+	reference.orbit = referenceOrbit(bigComplex(complex(0), fracLimbs), view.center, view.magn, maxIter + 1, bailout);
+	reference.deltaIsParameter = true;
+	reference.startIndex = 1;
+	reference.bla = blaTable(reference.orbit, 1, true, view.maxDelta);
+	return reference;
+}
+
+inline perturbationReference juliaReference(const deepZoomView &view, const complex &seed, const int maxIter, const double bailout)
+{
+	perturbationReference reference;
+	const int fracLimbs = view.center.x.precisionBits() / 32;
+	const bigComplex c(seed, fracLimbs);
+	reference.orbit = referenceOrbit(view.center, c, view.magn, maxIter, bailout);
+	reference.criticalOrbit = referenceOrbit(bigComplex(complex(0), fracLimbs), c, view.magn, maxIter, bailout);
+	reference.bla = blaTable(reference.orbit, 0, false, view.maxDelta);
+	reference.criticalBla = blaTable(reference.criticalOrbit, 0, false, view.maxDelta);
+	return reference;
+}
+
+// continues a sample at offset dz to orbit[m] after iter iterations, the
+// trap of the settings is honoured (it only looks at z), cycle detection and
+// the cardioid test need precise absolute values and are left out;
+// iterations covered by BLA steps are added to skipped
+inline orbitResult perturbedOrbit(const perturbationReference &reference, const complex &dc, complex dz,
+	const std::vector<complex> *orbit, int m, int iter, const quadraticSettings &settings, long long &skipped)
+{
+	const std::vector<complex> &rebase = reference.rebaseOrbit();
+	const double trapRadius2 = settings.trapRadius * settings.trapRadius;
+	complex z = (*orbit)[m] + dz;
+	while (iter < settings.maxIter)
+	{
+		if (m + 1 >= (int)orbit->size())
+		{
+			// the reference escaped before the sample
+			dz = z;
+			m = 0;
+			orbit = &rebase;
+		}
+		const blaStep *step = (reference.useBla) ? reference.table(orbit).lookup(m, dz.cabs_squared(), settings.maxIter - iter) : nullptr;
+		if (step != nullptr)
+		{
+			dz = step->A * dz + step->B * dc;
+			m += step->length;
+			iter += step->length;
+			skipped += step->length;
+		}
+		else
+		{
+			dz = (2 * (*orbit)[m] + dz) * dz + dc;
+			m++;
+			iter++;
+		}
+		z = (*orbit)[m] + dz;
+		const double z2 = z.cabs_squared();
+		if (z2 >= settings.bailout)
+			return {z, iter, true};
+		if (trapRadius2 > 0 && (z - settings.trapCenter).cabs_squared() < trapRadius2)
+			return {z, iter, false, true};
+		if (z2 < dz.cabs_squared())
+		{
+			dz = z;
+			m = 0;
+			orbit = &rebase;
+		}
+	}
+	return {z, iter, false};
+}
+
+// first iteration of a sample at offset delta from the view center
+inline orbitResult perturbedOrbit(const perturbationReference &reference, const complex &delta, const quadraticSettings &settings,
+	long long &skipped)
+{
+	const complex dc = (reference.deltaIsParameter) ? delta : complex(0);
+	return perturbedOrbit(reference, dc, delta, &reference.orbit, reference.startIndex, 0, settings, skipped);
+}
+
+// samples continued from an earlier render (see GBuffer.h) only know z, which
+// is the same as rebasing them
+inline orbitResult perturbedResume(const perturbationReference &reference, const complex &delta, const complex &zFrom,
+	const int iterFrom, const quadraticSettings &settings, long long &skipped)
+{
+	const complex dc = (reference.deltaIsParameter) ? delta : complex(0);
+	return perturbedOrbit(reference, dc, zFrom, &reference.rebaseOrbit(), 0, iterFrom, settings, skipped);
+}
+
+template <class Formula>
+void perturbationBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	const quadraticSettings settings = formula.deepZoomSettings();
+	long long iterations = 0;
+	long long skipped = 0;
+	for (int ii = 0; ii < n; ii++)
+	{
+		results[ii] = perturbedOrbit(formula.reference, z0[ii], settings, skipped);
+		iterations += results[ii].iter;
+	}
+	formula.reference.counters->iterations += iterations;
+	formula.reference.counters->skipped += skipped;
+}
+
+template <class Formula>
+void perturbationResumeBatch(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	const quadraticSettings settings = formula.deepZoomSettings();
+	long long iterations = 0;
+	long long skipped = 0;
+	for (int ii = 0; ii < n; ii++)
+	{
+		results[ii] = perturbedResume(formula.reference, z0[ii], zFrom[ii], iterFrom, settings, skipped);
+		iterations += results[ii].iter - iterFrom;
+	}
+	formula.reference.counters->iterations += iterations;
+	formula.reference.counters->skipped += skipped;
+}
+
+// samples iterated directly in T (doubleDouble or quadDouble), z0 are offsets from the view center
+template <class Formula, class T>
+void multiPrecisionBatch(abstractBaseFractal &fractal, const complex *z0, orbitResult *results, const int n)
+{
+	const Formula &formula = static_cast<const Formula&>(fractal);
+	const complexT<T> center = formula.view.center.template toComplexT<T>();
+	for (int ii = 0; ii < n; ii++)
+		results[ii] = formula.deepOrbit(center + complexT<T>(z0[ii]));
+}
+
+// continued samples only have z rounded to double, which is not enough to
+// go on from at these zooms, they are iterated again from the start instead
+// (still only the capped ones)
+template <class Formula, class T>
+void multiPrecisionResumeBatch(abstractBaseFractal &fractal, const complex *z0, const complex *zFrom, const int iterFrom, orbitResult *results, const int n)
+{
+	multiPrecisionBatch<Formula, T>(fractal, z0, results, n);
+}
@@ -0,0 +1,471 @@
+#pragma once
+#include <algorithm>
+
+#include "FastMath.h" // detectSimdLevel
+#include "IterationKernel.h"
+
+/* Batched SIMD escape time kernel for z -> z^2 + c
+
+   Iterates 4 (AVX2) or 8 (AVX-512) orbits in lockstep per vector, with two
+   independent vectors interleaved to hide the latency of the loop. Lanes whose orbit
+   escaped or hit maxIter stop updating (masked), and every few iterations
+   finished lanes write their result and are refilled with the next sample
+   of the batch, so one long orbit never stalls the other lanes. The
+   instruction set is picked at runtime, the same binary runs everywhere
+   and falls back to the scalar kernel on CPUs without AVX2.
+
+   The arithmetic per lane is the same as in quadraticOrbit (no FMA
+   contraction), so escaped orbits do not depend on the instruction set that
+   was picked.
+
+   Shallow views can also run in single precision, twice the lanes per
+   vector. singlePrecisionSuffices() decides from the pixel spacing whether
+   float still resolves the sample offsets well below a pixel. */
+
+// scalar reference path, c is read with stride cStride (0: same c for all samples)
+inline void quadraticBatchScalar(const complex *z0, const complex *c, const int cStride, orbitResult *results,
+	const int n, const quadraticSettings &settings)
+{
+	for (int ii = 0; ii < n; ii++)
+	{
+		if (settings.cardioidTest && inMainCardioidOrBulb(c[ii*cStride]))
+			results[ii] = {z0[ii], 0, false, true};
+		else
+			results[ii] = quadraticOrbit(z0[ii], c[ii*cStride], settings);
+	}
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MB_SIMD_KERNELS 1
+#include <immintrin.h>
+
+// lane bookkeeping shared by the SIMD kernels: the lane state lives in memory
+// between blocks of iterations, finished lanes are written out and refilled here.
+// Cycle detection runs here too, once per block: z is compared with a value saved
+// after 1, 2, 4, ... blocks, which finds every period p since p divides
+// simdUnroll * d for d = p blocks. R is the lane scalar (double or float).
+template <int W, class R = double>
+struct laneQueue
+{
+	alignas(64) R x[W], y[W], cx[W], cy[W], iter[W], escaped[W]; // escaped is 1 for bailed out lanes, 2 for trapped ones
+	R savedX[W], savedY[W];
+	int blocks[W], nextSave[W];
+	int sample[W]; // sample index in each lane, -1 for idle lanes
+	const complex *z0;
+	const complex *c;
+	int cStride;
+	orbitResult *results;
+	int n;
+	quadraticSettings settings;
+	double tolerance2;
+	int next = 0;
+	int busy = 0;
+
+	laneQueue(const complex *z0_, const complex *c_, const int cStride_, orbitResult *results_, const int n_,
+		const quadraticSettings &settings_)
+		: z0(z0_), c(c_), cStride(cStride_), results(results_), n(n_), settings(settings_),
+		  tolerance2(settings_.periodicityTolerance * settings_.periodicityTolerance)
+	{
+		for (int lane = 0; lane < W; lane++)
+			refill(lane);
+	}
+	void refill(const int lane)
+	{
+		// samples in the main cardioid or period 2 bulb never enter a lane
+		while (settings.cardioidTest && next < n && inMainCardioidOrBulb(c[next*cStride]))
+		{
+			results[next] = {z0[next], 0, false, true};
+			next++;
+		}
+		if (next < n)
+		{
+			x[lane] = z0[next].x;
+			y[lane] = z0[next].y;
+			cx[lane] = c[next*cStride].x;
+			cy[lane] = c[next*cStride].y;
+			iter[lane] = 0;
+			escaped[lane] = 0;
+			savedX[lane] = x[lane];
+			savedY[lane] = y[lane];
+			blocks[lane] = 0;
+			nextSave[lane] = 1;
+			sample[lane] = next++;
+			busy++;
+		}
+		else
+		{
+			x[lane] = y[lane] = cx[lane] = cy[lane] = 0;
+			iter[lane] = settings.maxIter; // idle, masked off for good
+			escaped[lane] = 0;
+			sample[lane] = -1;
+		}
+	}
+	bool cyclic(const int lane)
+	{
+		const double dx = (double)x[lane] - savedX[lane];
+		const double dy = (double)y[lane] - savedY[lane];
+		if (dx * dx + dy * dy < tolerance2)
+			return true;
+		if (++blocks[lane] == nextSave[lane])
+		{
+			savedX[lane] = x[lane];
+			savedY[lane] = y[lane];
+			nextSave[lane] *= 2;
+		}
+		return false;
+	}
+	// write out finished lanes and put new samples in their place, the kernels
+	// pass a bit mask of lanes that escaped or hit maxIter so the others are
+	// not touched (unless cycle detection has to look at every lane)
+	void collect(const uint64_t finished)
+	{
+		if (tolerance2 == 0)
+		{
+			for (uint64_t bits = finished; bits != 0; bits &= bits - 1)
+			{
+				const int lane = __builtin_ctzll(bits);
+				if (sample[lane] < 0)
+					continue;
+				results[sample[lane]] = {complex(x[lane], y[lane]), (int)iter[lane], escaped[lane] == 1, escaped[lane] == 2};
+				busy--;
+				refill(lane);
+			}
+			return;
+		}
+		for (int lane = 0; lane < W; lane++)
+		{
+			if (sample[lane] < 0)
+				continue;
+			if (escaped[lane] != 0 || iter[lane] >= settings.maxIter)
+			{
+				results[sample[lane]] = {complex(x[lane], y[lane]), (int)iter[lane], escaped[lane] == 1, escaped[lane] == 2};
+				busy--;
+				refill(lane);
+			}
+			else if (tolerance2 > 0 && cyclic(lane))
+			{
+				results[sample[lane]] = {complex(x[lane], y[lane]), (int)iter[lane], false, true};
+				busy--;
+				refill(lane);
+			}
+		}
+	}
+};
+
+constexpr int simdUnroll = 8; // iterations between checks for finished lanes
+
+// FMA contraction is switched off so every lane rounds exactly like quadraticOrbit
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+inline void quadraticBatchAvx2(const complex *z0, const complex *c, const int cStride,
+	orbitResult *results, const int n, const quadraticSettings &settings)
+{
+	constexpr int groups = 2;
+	laneQueue<4*groups> lanes(z0, c, cStride, results, n, settings);
+	const __m256d maxIterV = _mm256_set1_pd(settings.maxIter);
+	const __m256d bailoutV = _mm256_set1_pd(settings.bailout);
+	const __m256d one = _mm256_set1_pd(1.);
+	const __m256d two = _mm256_set1_pd(2.);
+	const __m256d zero = _mm256_setzero_pd();
+	const bool trap = settings.trapRadius > 0;
+	const __m256d trapX = _mm256_set1_pd(settings.trapCenter.x);
+	const __m256d trapY = _mm256_set1_pd(settings.trapCenter.y);
+	const __m256d trapRadius2 = _mm256_set1_pd(settings.trapRadius * settings.trapRadius);
+	const __m256d trapped = _mm256_set1_pd(2.);
+	__m256d x[groups], y[groups], cx[groups], cy[groups], iter[groups], escaped[groups], x2[groups], y2[groups];
+	while (lanes.busy > 0)
+	{
+		for (int gg = 0; gg < groups; gg++)
+		{
+			x[gg] = _mm256_load_pd(lanes.x + 4*gg);
+			y[gg] = _mm256_load_pd(lanes.y + 4*gg);
+			cx[gg] = _mm256_load_pd(lanes.cx + 4*gg);
+			cy[gg] = _mm256_load_pd(lanes.cy + 4*gg);
+			iter[gg] = _mm256_load_pd(lanes.iter + 4*gg);
+			escaped[gg] = _mm256_load_pd(lanes.escaped + 4*gg);
+			x2[gg] = _mm256_mul_pd(x[gg], x[gg]);
+			y2[gg] = _mm256_mul_pd(y[gg], y[gg]);
+		}
+		for (int kk = 0; kk < simdUnroll; kk++)
+		{
+			for (int gg = 0; gg < groups; gg++)
+			{
+				const __m256d active = _mm256_and_pd(_mm256_cmp_pd(iter[gg], maxIterV, _CMP_LT_OQ), _mm256_cmp_pd(escaped[gg], zero, _CMP_EQ_OQ));
+				const __m256d yNew = _mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(two, x[gg]), y[gg]), cy[gg]);
+				const __m256d xNew = _mm256_add_pd(_mm256_sub_pd(x2[gg], y2[gg]), cx[gg]);
+				x[gg] = _mm256_blendv_pd(x[gg], xNew, active);
+				y[gg] = _mm256_blendv_pd(y[gg], yNew, active);
+				x2[gg] = _mm256_mul_pd(x[gg], x[gg]);
+				y2[gg] = _mm256_mul_pd(y[gg], y[gg]);
+				iter[gg] = _mm256_add_pd(iter[gg], _mm256_and_pd(active, one));
+				const __m256d bailedOut = _mm256_and_pd(active, _mm256_cmp_pd(_mm256_add_pd(x2[gg], y2[gg]), bailoutV, _CMP_GE_OQ));
+				escaped[gg] = _mm256_blendv_pd(escaped[gg], one, bailedOut);
+				if (trap)
+				{
+					const __m256d dx = _mm256_sub_pd(x[gg], trapX);
+					const __m256d dy = _mm256_sub_pd(y[gg], trapY);
+					const __m256d inTrap = _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), trapRadius2, _CMP_LT_OQ);
+					escaped[gg] = _mm256_blendv_pd(escaped[gg], trapped, _mm256_andnot_pd(bailedOut, _mm256_and_pd(active, inTrap)));
+				}
+			}
+		}
+		uint64_t finished = 0;
+		for (int gg = 0; gg < groups; gg++)
+		{
+			_mm256_store_pd(lanes.x + 4*gg, x[gg]);
+			_mm256_store_pd(lanes.y + 4*gg, y[gg]);
+			_mm256_store_pd(lanes.iter + 4*gg, iter[gg]);
+			_mm256_store_pd(lanes.escaped + 4*gg, escaped[gg]);
+			finished |= (uint64_t)_mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(escaped[gg], zero, _CMP_NEQ_OQ),
+				_mm256_cmp_pd(iter[gg], maxIterV, _CMP_GE_OQ))) << (4*gg);
+		}
+		lanes.collect(finished);
+	}
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+inline void quadraticBatchAvx512(const complex *z0, const complex *c, const int cStride,
+	orbitResult *results, const int n, const quadraticSettings &settings)
+{
+	constexpr int groups = 2;
+	laneQueue<8*groups> lanes(z0, c, cStride, results, n, settings);
+	const __m512d maxIterV = _mm512_set1_pd(settings.maxIter);
+	const __m512d bailoutV = _mm512_set1_pd(settings.bailout);
+	const __m512d one = _mm512_set1_pd(1.);
+	const __m512d two = _mm512_set1_pd(2.);
+	const __m512d zero = _mm512_setzero_pd();
+	const bool trap = settings.trapRadius > 0;
+	const __m512d trapX = _mm512_set1_pd(settings.trapCenter.x);
+	const __m512d trapY = _mm512_set1_pd(settings.trapCenter.y);
+	const __m512d trapRadius2 = _mm512_set1_pd(settings.trapRadius * settings.trapRadius);
+	const __m512d trapped = _mm512_set1_pd(2.);
+	__m512d x[groups], y[groups], cx[groups], cy[groups], iter[groups], escaped[groups], x2[groups], y2[groups];
+	while (lanes.busy > 0)
+	{
+		for (int gg = 0; gg < groups; gg++)
+		{
+			x[gg] = _mm512_load_pd(lanes.x + 8*gg);
+			y[gg] = _mm512_load_pd(lanes.y + 8*gg);
+			cx[gg] = _mm512_load_pd(lanes.cx + 8*gg);
+			cy[gg] = _mm512_load_pd(lanes.cy + 8*gg);
+			iter[gg] = _mm512_load_pd(lanes.iter + 8*gg);
+			escaped[gg] = _mm512_load_pd(lanes.escaped + 8*gg);
+			x2[gg] = _mm512_mul_pd(x[gg], x[gg]);
+			y2[gg] = _mm512_mul_pd(y[gg], y[gg]);
+		}
+		for (int kk = 0; kk < simdUnroll; kk++)
+		{
+			for (int gg = 0; gg < groups; gg++)
+			{
+				const __mmask8 active = _mm512_cmp_pd_mask(iter[gg], maxIterV, _CMP_LT_OQ) & _mm512_cmp_pd_mask(escaped[gg], zero, _CMP_EQ_OQ);
+				const __m512d yNew = _mm512_add_pd(_mm512_mul_pd(_mm512_mul_pd(two, x[gg]), y[gg]), cy[gg]);
+				x[gg] = _mm512_mask_add_pd(x[gg], active, _mm512_sub_pd(x2[gg], y2[gg]), cx[gg]);
+				y[gg] = _mm512_mask_mov_pd(y[gg], active, yNew);
+				x2[gg] = _mm512_mul_pd(x[gg], x[gg]);
+				y2[gg] = _mm512_mul_pd(y[gg], y[gg]);
+				iter[gg] = _mm512_mask_add_pd(iter[gg], active, iter[gg], one);
+				const __mmask8 bailedOut = _mm512_mask_cmp_pd_mask(active, _mm512_add_pd(x2[gg], y2[gg]), bailoutV, _CMP_GE_OQ);
+				escaped[gg] = _mm512_mask_mov_pd(escaped[gg], bailedOut, one);
+				if (trap)
+				{
+					const __m512d dx = _mm512_sub_pd(x[gg], trapX);
+					const __m512d dy = _mm512_sub_pd(y[gg], trapY);
+					const __mmask8 inTrap = _mm512_mask_cmp_pd_mask(active & ~bailedOut,
+						_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)), trapRadius2, _CMP_LT_OQ);
+					escaped[gg] = _mm512_mask_mov_pd(escaped[gg], inTrap, trapped);
+				}
+			}
+		}
+		uint64_t finished = 0;
+		for (int gg = 0; gg < groups; gg++)
+		{
+			_mm512_store_pd(lanes.x + 8*gg, x[gg]);
+			_mm512_store_pd(lanes.y + 8*gg, y[gg]);
+			_mm512_store_pd(lanes.iter + 8*gg, iter[gg]);
+			_mm512_store_pd(lanes.escaped + 8*gg, escaped[gg]);
+			finished |= (uint64_t)(_mm512_cmp_pd_mask(escaped[gg], zero, _CMP_NEQ_OQ) | _mm512_cmp_pd_mask(iter[gg], maxIterV, _CMP_GE_OQ)) << (8*gg);
+		}
+		lanes.collect(finished);
+	}
+}
+
+// single precision versions of the kernels above, same structure with twice the lanes
+__attribute__((target("avx2"), optimize("fp-contract=off")))
+inline void quadraticBatchAvx2Single(const complex *z0, const complex *c, const int cStride,
+	orbitResult *results, const int n, const quadraticSettings &settings)
+{
+	constexpr int groups = 2;
+	laneQueue<8*groups, float> lanes(z0, c, cStride, results, n, settings);
+	const __m256 maxIterV = _mm256_set1_ps(settings.maxIter);
+	const __m256 bailoutV = _mm256_set1_ps(settings.bailout);
+	const __m256 one = _mm256_set1_ps(1.f);
+	const __m256 two = _mm256_set1_ps(2.f);
+	const __m256 zero = _mm256_setzero_ps();
+	const bool trap = settings.trapRadius > 0;
+	const __m256 trapX = _mm256_set1_ps(settings.trapCenter.x);
+	const __m256 trapY = _mm256_set1_ps(settings.trapCenter.y);
+	const __m256 trapRadius2 = _mm256_set1_ps(settings.trapRadius * settings.trapRadius);
+	const __m256 trapped = _mm256_set1_ps(2.f);
+	__m256 x[groups], y[groups], cx[groups], cy[groups], iter[groups], escaped[groups], x2[groups], y2[groups];
+	while (lanes.busy > 0)
+	{
+		for (int gg = 0; gg < groups; gg++)
+		{
+			x[gg] = _mm256_load_ps(lanes.x + 8*gg);
+			y[gg] = _mm256_load_ps(lanes.y + 8*gg);
+			cx[gg] = _mm256_load_ps(lanes.cx + 8*gg);
+			cy[gg] = _mm256_load_ps(lanes.cy + 8*gg);
+			iter[gg] = _mm256_load_ps(lanes.iter + 8*gg);
+			escaped[gg] = _mm256_load_ps(lanes.escaped + 8*gg);
+			x2[gg] = _mm256_mul_ps(x[gg], x[gg]);
+			y2[gg] = _mm256_mul_ps(y[gg], y[gg]);
+		}
+		for (int kk = 0; kk < simdUnroll; kk++)
+		{
+			for (int gg = 0; gg < groups; gg++)
+			{
+				const __m256 active = _mm256_and_ps(_mm256_cmp_ps(iter[gg], maxIterV, _CMP_LT_OQ), _mm256_cmp_ps(escaped[gg], zero, _CMP_EQ_OQ));
+				const __m256 yNew = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(two, x[gg]), y[gg]), cy[gg]);
+				const __m256 xNew = _mm256_add_ps(_mm256_sub_ps(x2[gg], y2[gg]), cx[gg]);
+				x[gg] = _mm256_blendv_ps(x[gg], xNew, active);
+				y[gg] = _mm256_blendv_ps(y[gg], yNew, active);
+				x2[gg] = _mm256_mul_ps(x[gg], x[gg]);
+				y2[gg] = _mm256_mul_ps(y[gg], y[gg]);
+				iter[gg] = _mm256_add_ps(iter[gg], _mm256_and_ps(active, one));
+				const __m256 bailedOut = _mm256_and_ps(active, _mm256_cmp_ps(_mm256_add_ps(x2[gg], y2[gg]), bailoutV, _CMP_GE_OQ));
+				escaped[gg] = _mm256_blendv_ps(escaped[gg], one, bailedOut);
+				if (trap)
+				{
+					const __m256 dx = _mm256_sub_ps(x[gg], trapX);
+					const __m256 dy = _mm256_sub_ps(y[gg], trapY);
+					const __m256 inTrap = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), trapRadius2, _CMP_LT_OQ);
+					escaped[gg] = _mm256_blendv_ps(escaped[gg], trapped, _mm256_andnot_ps(bailedOut, _mm256_and_ps(active, inTrap)));
+				}
+			}
+		}
+		uint64_t finished = 0;
+		for (int gg = 0; gg < groups; gg++)
+		{
+			_mm256_store_ps(lanes.x + 8*gg, x[gg]);
+			_mm256_store_ps(lanes.y + 8*gg, y[gg]);
+			_mm256_store_ps(lanes.iter + 8*gg, iter[gg]);
+			_mm256_store_ps(lanes.escaped + 8*gg, escaped[gg]);
+			finished |= (uint64_t)_mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(escaped[gg], zero, _CMP_NEQ_OQ),
+				_mm256_cmp_ps(iter[gg], maxIterV, _CMP_GE_OQ))) << (8*gg);
+		}
+		lanes.collect(finished);
+	}
+}
+
+__attribute__((target("avx512f"), optimize("fp-contract=off")))
+inline void quadraticBatchAvx512Single(const complex *z0, const complex *c, const int cStride,
+	orbitResult *results, const int n, const quadraticSettings &settings)
+{
+	constexpr int groups = 2;
+	laneQueue<16*groups, float> lanes(z0, c, cStride, results, n, settings);
+	const __m512 maxIterV = _mm512_set1_ps(settings.maxIter);
+	const __m512 bailoutV = _mm512_set1_ps(settings.bailout);
+	const __m512 one = _mm512_set1_ps(1.f);
+	const __m512 two = _mm512_set1_ps(2.f);
+	const __m512 zero = _mm512_setzero_ps();
+	const bool trap = settings.trapRadius > 0;
+	const __m512 trapX = _mm512_set1_ps(settings.trapCenter.x);
+	const __m512 trapY = _mm512_set1_ps(settings.trapCenter.y);
+	const __m512 trapRadius2 = _mm512_set1_ps(settings.trapRadius * settings.trapRadius);
+	const __m512 trapped = _mm512_set1_ps(2.f);
+	__m512 x[groups], y[groups], cx[groups], cy[groups], iter[groups], escaped[groups], x2[groups], y2[groups];
+	while (lanes.busy > 0)
+	{
+		for (int gg = 0; gg < groups; gg++)
+		{
+			x[gg] = _mm512_load_ps(lanes.x + 16*gg);
+			y[gg] = _mm512_load_ps(lanes.y + 16*gg);
+			cx[gg] = _mm512_load_ps(lanes.cx + 16*gg);
+			cy[gg] = _mm512_load_ps(lanes.cy + 16*gg);
+			iter[gg] = _mm512_load_ps(lanes.iter + 16*gg);
+			escaped[gg] = _mm512_load_ps(lanes.escaped + 16*gg);
+			x2[gg] = _mm512_mul_ps(x[gg], x[gg]);
+			y2[gg] = _mm512_mul_ps(y[gg], y[gg]);
+		}
+		for (int kk = 0; kk < simdUnroll; kk++)
+		{
+			for (int gg = 0; gg < groups; gg++)
+			{
+				const __mmask16 active = _mm512_cmp_ps_mask(iter[gg], maxIterV, _CMP_LT_OQ) & _mm512_cmp_ps_mask(escaped[gg], zero, _CMP_EQ_OQ);
+				const __m512 yNew = _mm512_add_ps(_mm512_mul_ps(_mm512_mul_ps(two, x[gg]), y[gg]), cy[gg]);
+				x[gg] = _mm512_mask_add_ps(x[gg], active, _mm512_sub_ps(x2[gg], y2[gg]), cx[gg]);
+				y[gg] = _mm512_mask_mov_ps(y[gg], active, yNew);
+				x2[gg] = _mm512_mul_ps(x[gg], x[gg]);
+				y2[gg] = _mm512_mul_ps(y[gg], y[gg]);
+				iter[gg] = _mm512_mask_add_ps(iter[gg], active, iter[gg], one);
+				const __mmask16 bailedOut = _mm512_mask_cmp_ps_mask(active, _mm512_add_ps(x2[gg], y2[gg]), bailoutV, _CMP_GE_OQ);
+				escaped[gg] = _mm512_mask_mov_ps(escaped[gg], bailedOut, one);
+				if (trap)
+				{
+					const __m512 dx = _mm512_sub_ps(x[gg], trapX);
+					const __m512 dy = _mm512_sub_ps(y[gg], trapY);
+					const __mmask16 inTrap = _mm512_mask_cmp_ps_mask(active & ~bailedOut,
+						_mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)), trapRadius2, _CMP_LT_OQ);
+					escaped[gg] = _mm512_mask_mov_ps(escaped[gg], inTrap, trapped);
+				}
+			}
+		}
+		uint64_t finished = 0;
+		for (int gg = 0; gg < groups; gg++)
+		{
+			_mm512_store_ps(lanes.x + 16*gg, x[gg]);
+			_mm512_store_ps(lanes.y + 16*gg, y[gg]);
+			_mm512_store_ps(lanes.iter + 16*gg, iter[gg]);
+			_mm512_store_ps(lanes.escaped + 16*gg, escaped[gg]);
+			finished |= (uint64_t)(_mm512_cmp_ps_mask(escaped[gg], zero, _CMP_NEQ_OQ) | _mm512_cmp_ps_mask(iter[gg], maxIterV, _CMP_GE_OQ)) << (16*gg);
+		}
+		lanes.collect(finished);
+	}
+}
+#endif
+
+using quadraticBatchFunction = void (*)(const complex *z0, const complex *c, const int cStride,
+	orbitResult *results, const int n, const quadraticSettings &settings);
+
+// resolved once on first use
+inline quadraticBatchFunction quadraticBatch()
+{
+	static const quadraticBatchFunction batch = []() -> quadraticBatchFunction
+	{
+#ifdef MB_SIMD_KERNELS
+		switch (detectSimdLevel())
+		{
+			case simdLevel::avx512: return &quadraticBatchAvx512;
+			case simdLevel::avx2:   return &quadraticBatchAvx2;
+			default: break;
+		}
+#endif
+		return &quadraticBatchScalar;
+	}();
+	return batch;
+}
+
+// single precision kernel, nullptr without SIMD (a scalar float loop gains nothing)
+inline quadraticBatchFunction quadraticBatchSingle()
+{
+	static const quadraticBatchFunction batch = []() -> quadraticBatchFunction
+	{
+#ifdef MB_SIMD_KERNELS
+		switch (detectSimdLevel())
+		{
+			case simdLevel::avx512: return &quadraticBatchAvx512Single;
+			case simdLevel::avx2:   return &quadraticBatchAvx2Single;
+			default: break;
+		}
+#endif
+		return nullptr;
+	}();
+	return batch;
+}
+
+// float is good enough if it resolves a 1/1024 pixel step everywhere in the view
+// (|z| up to extent) and counts up to maxIter exactly
+inline bool singlePrecisionSuffices(const double extent, const double pixelSpacing, const int maxIter)
+{
+	const double floatEpsilon = 1.1920929e-7;
+	return pixelSpacing >= 1024 * floatEpsilon * std::max(extent, 2.) && maxIter < (1 << 24);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+
+#include "Complex.h"
+
+/* Symmetric renders
+
+   Mandelbrot sets are symmetric under conjugation, quadratic Julia sets under
+   z -> -z. When the view (center, rotation, skew) happens to map such a set
+   symmetry onto a mirror of the pixel grid, only the pixels before their
+   mirror partner in memory order are rendered and the rest are copied from
+   the partner afterwards. A mirrored pixel then holds the mirror images of
+   its partner's jittered samples, which come from the same (symmetric) tent
+   filter distribution, so the copy is indistinguishable from rendering it.
+   Pixel x is centered on x, the image center is at (width/2, height/2), so
+   the mirror of column x is width - x and column 0 has no partner. */
+
+enum class setSymmetry { none, conjugate, origin };
+
+class pixelMirror
+{
+private:
+	int width = 0, height = 0;
+	bool flipX = false, flipY = false;
+
+	int partnerIndex(const int x, const int y) const
+	{
+		const int px = (flipX) ? width - x : x;
+		const int py = (flipY) ? height - y : y;
+		if (px >= width || py >= height)
+			return -1;
+		return py*width + px;
+	}
+
+public:
+	pixelMirror() {}
+
+	// coordinate maps pixel coordinates to the complex plane and must be affine,
+	// the mirror is only used if it reproduces the set symmetry to within
+	// tolerance (in units of pixels)
+	template <class Coordinate>
+	pixelMirror(const setSymmetry symmetry, const Coordinate &coordinate, const int width_, const int height_,
+		const double tolerance = 1e-3) : width(width_), height(height_)
+	{
+		if (symmetry == setSymmetry::none)
+			return;
+		const complex origin = coordinate(0., 0.);
+		const double pixelSpacing = (coordinate(1., 0.) - origin).cabs();
+		const auto apply = [symmetry](const complex &z) { return (symmetry == setSymmetry::conjugate) ? z.conj() : -1. * z; };
+		// an affine map is determined by three points
+		const double corners[3][2] = {{0, 0}, {(double)width, 0}, {0, (double)height}};
+		for (const bool mirrorX : {false, true})
+		{
+			for (const bool mirrorY : {false, true})
+			{
+				if (!mirrorX && !mirrorY)
+					continue;
+				bool matches = true;
+				for (const auto &p : corners)
+				{
+					const complex mirrored = coordinate((mirrorX) ? width - p[0] : p[0], (mirrorY) ? height - p[1] : p[1]);
+					matches = matches && (mirrored - apply(coordinate(p[0], p[1]))).cabs() < tolerance * pixelSpacing;
+				}
+				if (matches)
+				{
+					flipX = mirrorX;
+					flipY = mirrorY;
+					return;
+				}
+			}
+		}
+	}
+
+	bool active() const { return flipX || flipY; }
+	// pixel is filled in from its partner instead of being rendered
+	bool isCopy(const int x, const int y) const
+	{
+		if (!active())
+			return false;
+		const int partner = partnerIndex(x, y);
+		return partner >= 0 && partner < y*width + x;
+	}
+	// copies the channels values per pixel of the rendered half to the mirrored one
+	template <class T>
+	void fill(std::vector<T> &data, const int channels = 1) const
+	{
+		if (!active())
+			return;
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				if (!isCopy(x, y))
+					continue;
+				const int partner = partnerIndex(x, y);
+				for (int cc = 0; cc < channels; cc++)
+					data[(y*width + x)*channels + cc] = data[partner*channels + cc];
+			}
+		}
+	}
+};
@@ -0,0 +1,178 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <omp.h>
+
+/* Tile based work stealing scheduler
+
+   The image is cut into square regions and every region is rendered in
+   chunks of passes. A tile is one (region x pass range) unit of work. The
+   worker that finishes a tile writes its accumulation back into the image
+   and immediately continues with the next pass range of the same region,
+   so the accumulation buffer stays in cache for many passes and every
+   region is only ever touched by one thread at a time (no locking of the
+   image buffer needed). Idle workers steal whole regions from the back of
+   other workers' queues. */
+
+struct tile
+{
+	int x0, y0; // upper left pixel (inclusive)
+	int x1, y1; // lower right pixel (exclusive)
+	int passBegin, passEnd; // range of passes [passBegin, passEnd)
+	int width() const { return x1 - x0; }
+	int height() const { return y1 - y0; }
+	int pixels() const { return width() * height(); }
+};
+
+// double ended queue of tiles, the owner works on the front, thieves take from the back
+class workQueue
+{
+private:
+	std::deque<tile> tiles;
+	std::mutex lock;
+public:
+	void pushFront(const tile &t)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tiles.push_front(t);
+	}
+	void pushBack(const tile &t)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		tiles.push_back(t);
+	}
+	bool pop(tile &t)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (tiles.empty())
+			return false;
+		t = tiles.front();
+		tiles.pop_front();
+		return true;
+	}
+	bool steal(tile &t)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (tiles.empty())
+			return false;
+		t = tiles.back();
+		tiles.pop_back();
+		return true;
+	}
+};
+
+class tileScheduler
+{
+public:
+	// renders all passes of a tile into the (zeroed) local RGB accumulation buffer,
+	// pixel (x, y) of the image is at 3*((y - t.y0)*t.width() + x - t.x0)
+	// returns false once the region needs no further passes (adaptive sampling)
+	using tileRenderer = std::function<bool(const tile &t, std::vector<float> &accumulation)>;
+private:
+	std::vector<float> &image;
+	int imgWidth, imgHeight;
+	int maxPasses;
+	int tileSize;
+	int passesPerTile;
+	std::vector<workQueue> queues;
+	std::atomic<int> regionsLeft;
+	int regionsTotal;
+
+	void writeBack(const tile &t, const std::vector<float> &accumulation)
+	{
+		for (int ii = t.y0; ii < t.y1; ii++)
+		{
+			const int localRow = (ii - t.y0) * t.width();
+			for (int jj = t.x0; jj < t.x1; jj++)
+			{
+				const int pixelIndex = ii * imgWidth + jj;
+				const int localIndex = localRow + jj - t.x0;
+				image[3*pixelIndex    ] += accumulation[3*localIndex    ];
+				image[3*pixelIndex + 1] += accumulation[3*localIndex + 1];
+				image[3*pixelIndex + 2] += accumulation[3*localIndex + 2];
+			}
+		}
+	}
+
+	bool nextTile(const int worker, tile &t)
+	{
+		if (queues[worker].pop(t))
+			return true;
+		const int nWorkers = queues.size();
+		for (int ii = 1; ii < nWorkers; ii++)
+		{
+			if (queues[(worker + ii) % nWorkers].steal(t))
+				return true;
+		}
+		return false;
+	}
+
+	void finishRegion()
+	{
+		const int done = regionsTotal - --regionsLeft;
+		const int step = std::max(1, regionsTotal / 10);
+		if (done % step == 0)
+		{
+			#pragma omp critical (progress)
+			std::cout << "Regions done: " << done << "/" << regionsTotal << "\n";
+		}
+	}
+
+public:
+	tileScheduler(std::vector<float> &image_, const int imgWidth_, const int imgHeight_,
+		const int maxPasses_, const int tileSize_ = 32, const int passesPerTile_ = 64)
+		: image(image_), imgWidth(imgWidth_), imgHeight(imgHeight_), maxPasses(maxPasses_),
+		  tileSize(tileSize_), passesPerTile(passesPerTile_), regionsLeft(0), regionsTotal(0) {}
+
+	void run(const tileRenderer &renderTile)
+	{
+		const int nWorkers = omp_get_max_threads();
+		queues = std::vector<workQueue>(nWorkers);
+		// hand out contiguous blocks of regions so neighbouring regions start on the same worker
+		std::vector<tile> regions;
+		for (int y0 = 0; y0 < imgHeight; y0 += tileSize)
+			for (int x0 = 0; x0 < imgWidth; x0 += tileSize)
+				regions.push_back({x0, y0, std::min(x0 + tileSize, imgWidth), std::min(y0 + tileSize, imgHeight),
+					0, std::min(passesPerTile, maxPasses)});
+		const int nRegions = regions.size();
+		for (int ii = 0; ii < nRegions; ii++)
+			queues[(long long)ii * nWorkers / nRegions].pushBack(regions[ii]);
+		regionsLeft = nRegions;
+		regionsTotal = nRegions;
+
+		#pragma omp parallel num_threads(nWorkers)
+		{
+			const int worker = omp_get_thread_num();
+			std::vector<float> accumulation(3 * tileSize * tileSize);
+			tile t;
+			while (regionsLeft > 0)
+			{
+				if (!nextTile(worker, t))
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				std::fill(accumulation.begin(), accumulation.end(), 0.f);
+				const bool needsMorePasses = renderTile(t, accumulation);
+				writeBack(t, accumulation);
+				if (needsMorePasses && t.passEnd < maxPasses)
+				{
+					// keep the region on this worker, its data is still in cache
+					t.passBegin = t.passEnd;
+					t.passEnd = std::min(t.passEnd + passesPerTile, maxPasses);
+					queues[worker].pushFront(t);
+				}
+				else
+				{
+					finishRegion();
+				}
+			}
+		}
+	}
+};
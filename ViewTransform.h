@@ -0,0 +1,104 @@
+#pragma once
+#include <algorithm>
+
+#include "BigFixed.h"
+
+/* View transform
+
+   Maps pixel coordinates to the complex plane. Center, span, magnification,
+   rotation and skew are folded once per render into an affine map
+
+       offset(x, y) = origin + x xStep + y yStep
+
+   (a 2x3 matrix with the columns xStep, yStep and origin), the pixel
+   (x, y) lies at center + offset(x, y). Offsets are kept apart from the
+   center, which is also kept exactly: deep zoom kernels iterate offsets
+   from a high precision reference at the center (see Perturbation.h), and
+   shallow views add the center last, which rounds the sum only once.
+   Pixel x is centered on x, the image center is at (width/2, height/2). */
+
+class viewTransform
+{
+public:
+	bigComplex center; // exact center, deep zoom reference orbits start here
+	complex centerDouble = complex(0);
+	double magn = 1;
+	complex origin = complex(0); // offset of pixel (0, 0) from the center
+	complex xStep = complex(0); // offset from one pixel to the next along x
+	complex yStep = complex(0); // and along y
+
+	viewTransform() {}
+	// span is half the height of the view at magn 1, rotation a unit complex
+	// number, skew a 2x2 matrix applied last
+	viewTransform(const bigComplex &center_, const double magn_, const double span, const complex &rotation,
+		const double (&skew)[2][2], const int width, const int height)
+		: center(center_), centerDouble(center_.toComplex()), magn(magn_)
+	{
+		const double aspect = (double)width / height;
+		const double xRange = 2 * span * aspect;
+		const double yRange = 2 * span;
+		const auto linear = [&](const double u, const double v)
+		{
+			const complex w = rotation * complex(u, v) * (1. / this->magn);
+			return complex(skew[0][0] * w.x + skew[0][1] * w.y, skew[1][0] * w.x + skew[1][1] * w.y);
+		};
+		this->origin = linear(-0.5 * xRange, -0.5 * yRange);
+		this->xStep = linear(xRange / width, 0);
+		this->yStep = linear(0, yRange / height);
+	}
+
+	complex offset(const double x, const double y) const
+	{
+		return complex(this->origin.x + x * this->xStep.x + y * this->yStep.x,
+			this->origin.y + x * this->xStep.y + y * this->yStep.y);
+	}
+	complex coordinate(const double x, const double y) const { return this->centerDouble + this->offset(x, y); }
+
+	// offset of (0, y), samples along the row are rowOffset(y) + x xStep
+	complex rowOffset(const double y) const
+	{
+		return complex(this->origin.x + y * this->yStep.x, this->origin.y + y * this->yStep.y);
+	}
+	complex offsetInRow(const complex &row, const double x) const
+	{
+		return complex(row.x + x * this->xStep.x, row.y + x * this->xStep.y);
+	}
+
+	// offsets (or coordinates) of n pixel coordinates at once, the loop vectorizes
+	void offsets(const double *x, const double *y, complex *z, const int n) const
+	{
+		this->map(x, y, z, n, complex(0));
+	}
+	void coordinates(const double *x, const double *y, complex *z, const int n) const
+	{
+		this->map(x, y, z, n, this->centerDouble);
+	}
+
+	// distance between neighbouring pixel centers along x
+	double pixelSpacing() const { return this->xStep.cabs(); }
+	// largest offset from the center of the pixels of a width x height image
+	// and margin pixels beyond its border
+	double maxOffset(const int width, const int height, const double margin) const
+	{
+		double result = 0;
+		for (const double x : {-margin, width + margin})
+			for (const double y : {-margin, height + margin})
+				result = std::max(result, this->offset(x, y).cabs());
+		return result;
+	}
+
+private:
+	void map(const double *x, const double *y, complex *z, const int n, const complex &base) const
+	{
+		const complex o = this->origin;
+		const complex dx = this->xStep;
+		const complex dy = this->yStep;
+		// base is added to the offset last, as in coordinate()
+		#pragma omp simd
+		for (int ii = 0; ii < n; ii++)
+		{
+			z[ii].x = (o.x + x[ii] * dx.x + y[ii] * dy.x) + base.x;
+			z[ii].y = (o.y + x[ii] * dx.y + y[ii] * dy.y) + base.y;
+		}
+	}
+};
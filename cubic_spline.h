@@ -1,117 +1,116 @@
 #pragma once
 
-#include <iostream>
-#include <vector>
-#include <math.h>
-#include <iostream>
 #include <algorithm>
+#include <vector>
 
 #include "color.h"
 
-using std::cout;
-
-/* BASIC SOLVER FOR SYSTEMS OF LINEAR EQUATIONS
+/* CUBIC HERMITE SPLINE THROUGH CYCLIC COLOUR STOPS
+ *
+ * Between two neighbouring stops x1 < x2 each channel is the cubic with
+ * the stop values y1, y2 and the slopes s1, s2 at the ends. The slope at a
+ * stop is the central difference (y2 - y0) / (x2 - x0) over its neighbours,
+ * or 0 if the stop is a local maximum, so that the curve does not overshoot
+ * there. In the local coordinate t = (x - x1) / (x2 - x1) the cubic is
  *
- * This does NOT account for linearly dependent rows in the
- * coefficient matrix!!!
- * 
- * This code is also not optimized, do not use for systems of many
- * equations.
+ *     y(t) = ((a t + b) t + c) t + d,   d = y1,  c = h s1,
+ *     b = 3 (y2 - y1) - 2 h s1 - h s2,  a = 2 (y1 - y2) + h s1 + h s2
  *
- * Solves linear equations if matrix can be diagonlalized and
- * the solution is unique. This is fine for cubic splines because
- * the coefficients for those are always well defined and unique.
- * 
- * This code comes without guarantees. Make sure to double check the results
- * when using it!!
+ * with h = x2 - x1, so the coefficients follow in closed form once per
+ * segment. They are stored per channel in separate arrays (segment k
+ * starts at stop k, the last segment wraps around to the first stop), and
+ * sample() evaluates the spline at many positions in one vectorized sweep.
+ * Results are clamped to [0, 1].
  */
 
-std::vector<double> solve_linear_eqs(std::vector<double> M, std::vector<double> b)
+class CubicSpline
 {
-	int n = b.size();
-	for (int ii = 0; ii < n; ii++)
+private:
+	int length;
+	int n_segments;
+	std::vector<float> start, inv_width; // per segment
+	std::vector<float> coeffs[3][4]; // [channel][a, b, c, d], per segment
+
+	// slope at the stop y1 between y0 and y2 at x0 < x1 < x2
+	static float slope(const float x0, const float y0, const float y1, const float x2, const float y2)
 	{
-		for (int jj = 0; jj < n; jj++) 
+		return (y1 >= y0 && y1 >= y2) ? 0 : (y2 - y0) / (x2 - x0);
+	}
+	static float channel(const color &c, const int ch) { return (ch == 0) ? c.r : (ch == 1) ? c.g : c.b; }
+
+	// segment containing x in [0, length), before the first stop is the wrapped last segment
+	int segment_of(const float x) const
+	{
+		const int k = (int)(std::upper_bound(start.begin(), start.end(), x) - start.begin()) - 1;
+		return (k < 0) ? n_segments - 1 : k;
+	}
+
+public:
+	// stops at the (increasing) indices in [0, length_)
+	CubicSpline(const int length_, const std::vector<int> &indices, const std::vector<color> &colors)
+		: length(length_), n_segments(indices.size()), start(n_segments), inv_width(n_segments)
+	{
+		for (auto &channel_coeffs : coeffs)
+			for (auto &c : channel_coeffs)
+				c.resize(n_segments);
+		const int n = n_segments;
+		for (int k = 0; k < n; k++)
 		{
-			if (jj != ii) // do not use the row to eliminate itself, DUH!
+			// stops k - 1 .. k + 2, unwrapped around the cycle
+			const int i0 = (k + n - 1) % n, i2 = (k + 1) % n, i3 = (k + 2) % n;
+			const float x1 = indices[k];
+			const float x0 = indices[i0] - ((i0 >= k) ? length : 0);
+			const float x2 = indices[i2] + ((i2 <= k) ? length : 0);
+			const float x3 = indices[i3] + ((i3 <= k) ? length : 0) + ((n == 1) ? length : 0);
+			const float h = x2 - x1;
+			start[k] = x1;
+			inv_width[k] = 1.f / h;
+			for (int ch = 0; ch < 3; ch++)
 			{
-				if (M[(1+n)*ii] == 0)
-				{
-					// if there is a zero, do not use this row for the next step
-					// find a row below that does not have a zero in this column
-					int biggest_val_idx = 0;
-					double abs_val = 0;
-					for (int kk = ii+1; kk < n; kk++)
-					{
-						biggest_val_idx = (M[n*kk+ii] > abs_val) ? kk : biggest_val_idx;
-					}
-					// swap row ii with row biggest_index_val
-					for (int kk = 0; kk < n; kk++)
-					{
-						std::swap(M[n*ii+kk], M[n*biggest_val_idx+kk]);
-					}
-					std::swap(b[ii], b[biggest_val_idx]);
-				}
-				// once we're sure that M[n*ii+ii] is not zero, use it for eliminating
-				double fac = M[n*jj+ii]/M[n*ii+ii];
-				b[jj] = b[jj] - fac * b[ii];
-				for (int kk = 0; kk < n; kk++)
-				{
-					M[n*jj+kk] = M[n*jj+kk] - fac * M[n*ii+kk];
-				}
+				const float y0 = channel(colors[i0], ch), y1 = channel(colors[k], ch);
+				const float y2 = channel(colors[i2], ch), y3 = channel(colors[i3], ch);
+				const float c1 = h * slope(x0, y0, y1, x2, y2);
+				const float c2 = h * slope(x1, y1, y2, x3, y3);
+				coeffs[ch][0][k] = 2 * (y1 - y2) + c1 + c2;
+				coeffs[ch][1][k] = 3 * (y2 - y1) - 2 * c1 - c2;
+				coeffs[ch][2][k] = c1;
+				coeffs[ch][3][k] = y1;
 			}
 		}
 	}
-	for (int ii = 0; ii < n; ii++)
+
+	// colours at the n equally spaced positions ii * length / n into r, g, b
+	void sample(const int n, float *r, float *g, float *b) const
 	{
-		b[ii] = b[ii]/M[n*ii+ii];
-		M[n*ii+ii] = M[n*ii+ii]/M[n*ii+ii];
+		// the segment of each position (positions increase, so one merge pass)
+		// and its local coordinate, then all channels in vectorizable loops
+		std::vector<int> segment(n);
+		std::vector<float> t(n);
+		int k = segment_of(0);
+		for (int ii = 0; ii < n; ii++)
+		{
+			const float x = (float)ii * length / n;
+			if (k == n_segments - 1 && x >= start[0] && x < start[k])
+				k = 0;
+			while (k + 1 < n_segments && start[k + 1] <= x)
+				k++;
+			segment[ii] = k;
+			const float dx = x - start[k];
+			t[ii] = ((dx < 0) ? dx + length : dx) * inv_width[k];
+		}
+		float *out[3] = {r, g, b};
+		for (int ch = 0; ch < 3; ch++)
+		{
+			const float *ca = coeffs[ch][0].data(), *cb = coeffs[ch][1].data();
+			const float *cc = coeffs[ch][2].data(), *cd = coeffs[ch][3].data();
+			float *o = out[ch];
+			#pragma omp simd
+			for (int ii = 0; ii < n; ii++)
+			{
+				const int s = segment[ii];
+				const float value = ((ca[s] * t[ii] + cb[s]) * t[ii] + cc[s]) * t[ii] + cd[s];
+				o[ii] = std::min(1.f, std::max(0.f, value));
+			}
+		}
 	}
-	return b;
-}
-
-std::vector<double> calculate_spline_coefficients(std::vector<float> x, std::vector<float> y)
-{
-	// slopes, limit to 0 for extreme points
-	float s1 = (y[1] >= y[0] && y[1] >= y[2]) ? 0 : (y[2] - y[0]) / (x[2] - x[0]);
-	float s2 = (y[2] >= y[1] && y[2] >= y[3]) ? 0 : (y[3] - y[1]) / (x[3] - x[1]);
-	//cout << "Slopes: " << s1 << ", " << s2 << "\n";
-	std::vector<double> M = {
-			pow(x[1], 3), pow(x[1], 2), x[1], 1,
-		3 * pow(x[1], 2),     2 * x[1],    1, 0,
-			pow(x[2], 3), pow(x[2], 2), x[2], 1,
-		3 * pow(x[2], 2),     2 * x[2],    1, 0 };
-	std::vector<double> b = { y[1], s1, y[2], s2 };
-	std::vector<double> coeffs = solve_linear_eqs(M, b);
-	return coeffs;
-}
-
-inline double cubic(std::vector<double>& coefficients, double x)
-{
-	return coefficients[0] * x * x * x + coefficients[1] * x * x + coefficients[2] * x + coefficients[3];
-}
-
-inline double clamp(double x) { return std::min(0., std::max(1., x)); }
-
-color splined_color(std::vector<float> x, std::vector<color> colors, float index)
-{
-	//cout << "Received 4 indices and 4 colors:\n";
-	//for (int ii = 0; ii < 4; ii++)
-	//{
-	//	cout << "index: " << x[ii] << " color: " << colors[ii].r << " " << colors[ii].g << " " << colors[ii].b << "\n";
-	//}
-	std::vector<double> coeffsRed = calculate_spline_coefficients(
-		x, { colors[0].r, colors[1].r, colors[2].r, colors[3].r });
-	std::vector<double> coeffsGreen = calculate_spline_coefficients(
-		x, { colors[0].g, colors[1].g, colors[2].g, colors[3].g });
-	std::vector<double> coeffsBlue = calculate_spline_coefficients(
-		x, { colors[0].b, colors[1].b, colors[2].b, colors[3].b });
-	//cout << coeffsBlue[0] << "\n";
-	return color(
-		// clamp(cubic(coeffsRed, index)),	
-		// clamp(cubic(coeffsGreen, index)),
-		// clamp(cubic(coeffsBlue, index)));
-		std::min(1.f, (std::max(0.f, (float)(coeffsRed[0] * std::pow(index, 3) + coeffsRed[1] * std::pow(index, 2) + coeffsRed[2] * index + coeffsRed[3])))),
-		std::min(1.f, (std::max(0.f, (float)(coeffsGreen[0] * std::pow(index, 3) + coeffsGreen[1] * std::pow(index, 2) + coeffsGreen[2] * index + coeffsGreen[3])))),
-		std::min(1.f, (std::max(0.f, (float)(coeffsBlue[0] * std::pow(index, 3) + coeffsBlue[1] * std::pow(index, 2) + coeffsBlue[2] * index + coeffsBlue[3])))));
-}
+};
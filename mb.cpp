@@ -6,7 +6,14 @@
 #include <chrono>
 
 #include "FractalFormulas.h"
+#include "FormulaCompiler.h"
 #include "Gradient.h"
+#include "GradientFile.h"
+#include "TileScheduler.h"
+#include "AdaptiveSampling.h"
+#include "GBuffer.h"
+#include "BoundaryTracing.h"
+#include "ViewTransform.h"
 
 using std::cout;
 using std::endl;
@@ -14,22 +21,6 @@ using std::ostream;
 
 const double pi = 3.14159265359;
 
-// get complex coordinate for the (sub)pixel coordinates using
-// center, zoom and image dimensions
-complex getComplexCoordinate(const double x, const double y, const complex center, const double magn,
-	const complex rotation, const std::vector<std::vector<double>> &skew, const double span, const int imgWidth, const int imgHeight)
-{
-	const double aspect = (double)imgWidth / imgHeight;
-	const double xRange = 2 * span * aspect;
-	const double yRange = 2 * span;
-	complex z(((x/imgWidth) - 0.5)*xRange, ((y/imgHeight) - 0.5)*yRange);
-	z = rotation * z * (1./ magn);
-	z = complex(skew[0][0] * z.x + skew[0][1] * z.y, skew[1][0] * z.x + skew[1][1] * z.y);
-	return z + center;
-}
-
-
-
 // AA stuff
 // int to double
 double uintToDouble(const uint32_t n)
@@ -81,8 +72,8 @@ double halton(int i)
 	return r;
 }
 
-// write to PPM
-void writeImage(const std::vector<float> &imgData, const int &imgWidth, const int &imgHeight, const int &maxPasses)
+// write to PPM, every pixel is divided by the number of samples it received
+void writeImage(const std::vector<float> &imgData, const std::vector<int> &sampleCount, const int &imgWidth, const int &imgHeight)
 {
 	std::ofstream ofs("test4.ppm");
 	ofs << "P6" << endl << imgWidth << " " << imgHeight << endl << "255" << endl;
@@ -91,18 +82,75 @@ void writeImage(const std::vector<float> &imgData, const int &imgWidth, const in
 		for (int ii = 0; ii < imgWidth; ii++)
 		{
 			int pixelIndex = jj*imgWidth + ii;
-			// int colR = (int)(linearToSRGB(imgData[pixelIndex*3  ]/maxPasses)*255);
-			// int colG = (int)(linearToSRGB(imgData[pixelIndex*3+1]/maxPasses)*255);
-			// int colB = (int)(linearToSRGB(imgData[pixelIndex*3+2]/maxPasses)*255);
-			int colR = (int)(imgData[pixelIndex*3  ]/maxPasses*255);
-			int colG = (int)(imgData[pixelIndex*3+1]/maxPasses*255);
-			int colB = (int)(imgData[pixelIndex*3+2]/maxPasses*255);
+			const float invSamples = 1.f / std::max(1, sampleCount[pixelIndex]);
+			// int colR = (int)(linearToSRGB(imgData[pixelIndex*3  ]*invSamples)*255);
+			// int colG = (int)(linearToSRGB(imgData[pixelIndex*3+1]*invSamples)*255);
+			// int colB = (int)(linearToSRGB(imgData[pixelIndex*3+2]*invSamples)*255);
+			int colR = (int)(imgData[pixelIndex*3  ]*invSamples*255);
+			int colG = (int)(imgData[pixelIndex*3+1]*invSamples*255);
+			int colB = (int)(imgData[pixelIndex*3+2]*invSamples*255);
 			ofs << (char)colR << (char)colG << (char)colB;
 		}
 	}
 	ofs.close();
 }
 
+// colour mapping from iteration results, shared by the render loop and the G-buffer recolouring
+const Gradient *sampleGradient = nullptr; // set in main
+inline float gradientPosition(const int iter) { return 0.1*sqrt((float)iter); }
+color sampleColor(const int iter, const bool bailedOut)
+{
+	//return (bailedOut) ? sRGBtoLinear(standard_muted().get_color(0.1*sqrt((float)iter))) : color(0);
+	return (bailedOut) ? sampleGradient->get_color(gradientPosition(iter)) : color(0);
+	//return (bailedOut) ? standard_muted().get_color(0.1*sqrt((float)iter)) : color(0);
+	//return (bailedOut) ? standard_muted().get_color(0.05*(float)iter) : color(0);
+	//return (bailedOut) ? ((iter/5)%2 == 1) ? color(1) : color(0) : color(0);
+}
+// sampleColor of n results with their gradient positions, the gradient
+// lookups are done in one batch, prefiltered over footprints unless that is nullptr
+void sampleColors(const orbitResult *results, const float *positions, const float *footprints, color *colors, const int n)
+{
+	if (footprints != nullptr)
+		sampleGradient->get_colors(positions, footprints, colors, n);
+	else
+		sampleGradient->get_colors(positions, colors, n);
+	for (int ii = 0; ii < n; ii++)
+		colors[ii] = (results[ii].bailedOut) ? colors[ii] : color(0);
+}
+// gradient footprints of the samples of one pass over a tile: how far the
+// gradient position moves to the samples of the neighbouring pixels in the
+// same pass (finite differences, like ddx / ddy on a GPU). slot holds the
+// batch index of every pixel of the tile, -1 for pixels without an iterated
+// sample. Only escaped neighbours count, samples without any get footprint 0.
+// The samples of a pixel share its area, with n of them each one stands for
+// a 1/sqrt(n) wide part of it, scale is that factor.
+void sampleFootprints(const orbitResult *results, const float *positions, const std::vector<int> &slot,
+	const int tileWidth, const int tileHeight, const float scale, float *footprints)
+{
+	for (int y = 0; y < tileHeight; y++)
+	{
+		for (int x = 0; x < tileWidth; x++)
+		{
+			const int kk = slot[y*tileWidth + x];
+			if (kk < 0)
+				continue;
+			// -1 if there is no escaped sample at (nx, ny)
+			const auto difference = [&](const int nx, const int ny)
+			{
+				if (nx < 0 || nx >= tileWidth || ny < 0 || ny >= tileHeight)
+					return -1.f;
+				const int neighbour = slot[ny*tileWidth + nx];
+				return (neighbour < 0 || !results[neighbour].bailedOut) ? -1.f : std::abs(positions[neighbour] - positions[kk]);
+			};
+			float dx = difference(x + 1, y);
+			dx = (dx < 0) ? difference(x - 1, y) : dx;
+			float dy = difference(x, y + 1);
+			dy = (dy < 0) ? difference(x, y - 1) : dy;
+			footprints[kk] = scale * std::max(0.f, std::max(dx, dy));
+		}
+	}
+}
+
 void test_operators()
 {
 	cout << "Testing complex functions and operators\n\n";
@@ -155,91 +203,371 @@ void test_operators()
 
 }
 
+// accuracy (largest error in ulp) and throughput of the FastMath.h batch
+// functions against libm, over ranges orbits typically visit
+void test_fastmath()
+{
+	cout << "Testing fast math functions against libm\n\n";
+	const int n = 1 << 20;
+	std::vector<double> x(n), y(n), result(n), other(n);
+	for (int ii = 0; ii < n; ii++)
+	{
+		x[ii] = -20. + 40. * (ii + 0.5) / n;
+		y[ii] = 1e-3 + 1e3 * std::fmod(ii * 0.6180339887498949, 1.);
+	}
+	const auto ulp = [](const double value, const double reference)
+	{
+		const double spacing = std::nextafter(std::abs(reference), INFINITY) - std::abs(reference);
+		return std::abs(value - reference) / spacing;
+	};
+	const auto seconds = [](const auto &f)
+	{
+		const auto t1 = std::chrono::high_resolution_clock::now();
+		f();
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t1).count();
+	};
+	const auto report = [&](const char *name, const auto &fast, const auto &reference, const auto &libm)
+	{
+		const double fastTime = seconds(fast);
+		double worst = 0;
+		for (int ii = 0; ii < n; ii++)
+			worst = std::max(worst, ulp(result[ii], reference(ii)));
+		const double libmTime = seconds(libm);
+		cout << name << ": max error " << worst << " ulp, " << fastTime / n * 1e9 << " ns vs libm "
+			<< libmTime / n * 1e9 << " ns per value\n";
+	};
+	report("exp", [&] { fastExp(x.data(), result.data(), n); },
+		[&](const int ii) { return std::exp(x[ii]); },
+		[&] { for (int ii = 0; ii < n; ii++) other[ii] = std::exp(x[ii]); });
+	report("log", [&] { fastLog(y.data(), result.data(), n); },
+		[&](const int ii) { return std::log(y[ii]); },
+		[&] { for (int ii = 0; ii < n; ii++) other[ii] = std::log(y[ii]); });
+	report("sin (sincos)", [&] { fastSinCos(x.data(), result.data(), other.data(), n); },
+		[&](const int ii) { return std::sin(x[ii]); },
+		[&] { for (int ii = 0; ii < n; ii++) { result[ii] = std::sin(x[ii]); other[ii] = std::cos(x[ii]); } });
+	report("atan2", [&] { fastAtan2(x.data(), y.data(), result.data(), n); },
+		[&](const int ii) { return std::atan2(x[ii], y[ii]); },
+		[&] { for (int ii = 0; ii < n; ii++) other[ii] = std::atan2(x[ii], y[ii]); });
+	report("sinh (sinhcosh)", [&] { fastSinhCosh(x.data(), result.data(), other.data(), n); },
+		[&](const int ii) { return std::sinh(x[ii]); },
+		[&] { for (int ii = 0; ii < n; ii++) { result[ii] = std::sinh(x[ii]); other[ii] = std::cosh(x[ii]); } });
+}
 
 int main()
 {
       //omp_set_num_threads(4);
 	// test_operators();
+	// test_fastmath();
 	// return 0;
 	// image dimensions
 	const int imgMult = 240 	; // 1280x720
 	const int imgWidth = 16*imgMult;
 	const int imgHeight =9*imgMult;
-	// location in the complex plane
-	const complex center(-0.5, 0);
+	// location in the complex plane, the center is given as decimal strings so
+	// deep zooms keep all of its digits
+	const std::string centerX = "-0.5";
+	const std::string centerY = "0";
 	const double angle = 0. / 180. * pi;
 	const complex rotation = complex(std::cos(angle), std::sin(angle));
-	const std::vector<std::vector<double>> skew{ {1, 0}, {0, 1 }};
+	const double skew[2][2] = {{1, 0}, {0, 1}};
 	const double magn = 1;
+	// beyond this doubles can not tell neighbouring pixels apart, samples are
+	// then iterated as offsets from a high precision reference orbit, or up to
+	// magn 1e60 directly in double-double / quad-double if perturbation is off
+	const bool deepZoom = precisionForMagnification(magn) != precisionLevel::standard;
+	const bool perturbation = true;
+	const int centerLimbs = fracLimbsForMagnification(magn);
+	const bigComplex bigCenter(bigFixed(centerX, centerLimbs), bigFixed(centerY, centerLimbs));
 
 	// other parameters:
 	// const char* fractalName = "morphingMB";
+	// a built in formula or a formula file (.frm, see FormulaCompiler.h), e.g. "formulas/BurningShip.frm"
+	const std::string fractalName = "JuliaSet";
 	const double span = 1.5; // base size of region shown
+	// pixel to complex plane map, set up once for the whole render
+	const viewTransform transform(bigCenter, magn, span, rotation, skew, imgWidth, imgHeight);
 	// const complex seed(-0.4, 0.6); // Julia seed
 	// const int maxIter = 2550;
 	const int maxPasses = 1024;
 	const double invMaxPasses = 1./maxPasses;
 
+	// colouring gradient: a library gradient (Gradient.h) or the first one of a
+	// gradient file (.ugr / .map, see GradientFile.h), baked gradient files are
+	// kept in gradientCacheFile
+	const std::string gradientName = "volcano_under_a_glacier";
+	const std::string gradientCacheFile = "gradients.cache";
+	std::vector<namedGradient> fileGradients;
+	if (isGradientFile(gradientName))
+	{
+		gradientCache cache;
+		if (!cache.open(gradientCacheFile))
+			cout << "Could not open the gradient cache " << gradientCacheFile << "\n";
+		fileGradients = loadGradients(gradientName, &cache);
+		sampleGradient = (fileGradients.empty()) ? nullptr : &fileGradients[0].gradient;
+	}
+	else
+		sampleGradient = getGradient(gradientName);
+	if (sampleGradient == nullptr)
+	{
+		cout << "Unknown gradient " << gradientName << "\n";
+		return 1;
+	}
+	// prefilter the gradient over the footprint of every sample (see Gradient.h),
+	// banded regions then converge with far fewer passes
+	const bool filterGradient = true;
+
 	std::vector<float> image(imgWidth*imgHeight*3, 0);
-	//abstractBaseFractal* fractal_ = getFractal(fractalName);
-	//fractalParameters params = fractal_->params;
-	//params.complexParameters["seed"] = complex(0.0987, 0.2412);
-	//params.complexParameters["seed"] = complex(0.27, 0);
+
+	// G-buffer: keep the iteration results of every sample on disk so the colouring
+	// can be redone without iterating, recolorOnly skips rendering and only
+	// colours an existing G-buffer, continueRender continues the samples of an
+	// existing G-buffer that hit its maxIter up to the formula's (higher) maxIter
+	const bool writeGBuffer = false;
+	const bool recolorOnly = false;
+	const bool continueRender = false;
+	const std::string gBufferFile = "test4.gbuf";
+	gBuffer gbuf;
+	if (recolorOnly)
+	{
+		if (!gbuf.open(gBufferFile))
+		{
+			cout << "Could not open G-buffer " << gBufferFile << "\n";
+			return 1;
+		}
+		std::vector<int> sampleCount;
+		recolor(gbuf, [](const gSample &s) { return sampleColor(s.iter(), s.bailedOut()); }, image, sampleCount);
+		writeImage(image, sampleCount, gbuf.width(), gbuf.height());
+		return 0;
+	}
+	//fractalParameters params;
+	//params.set("seed", complex(0.0987, 0.2412));
+	//params.set("seed", complex(0.27, 0));
 	//cout << "Calling factory... ";
-	// abstractBaseFractal* fractal = getFractal(fractalName); //, params); 
+	abstractBaseFractal* fractal = (isFormulaFile(fractalName)) ? loadFormula(fractalName) : getFractal(fractalName); //, params); 
+	if (fractal == nullptr)
+	{
+		cout << "Unknown fractal formula " << fractalName << "\n";
+		return 1;
+	}
+	// largest offset of a sample from the center (jitter reaches one pixel past the border)
+	const double maxDelta = transform.maxOffset(imgWidth, imgHeight, 1);
+	deepZoomView view;
+	view.center = bigCenter;
+	view.magn = magn;
+	view.maxDelta = maxDelta;
+	view.perturbation = perturbation;
+	if (deepZoom && !fractal->setDeepZoom(view))
+	{
+		cout << "No deep zoom mode for " << fractalName << "\n";
+		return 1;
+	}
+	const int maxIter = fractal->maxIterations();
+	// shallow views iterate in float with twice the SIMD width, as long as float
+	// resolves the sample offsets well below a pixel
+	const double pixelSpacing = transform.pixelSpacing();
+	const bool singlePrecision = !deepZoom && singlePrecisionSuffices(transform.centerDouble.cabs() + maxDelta, pixelSpacing, maxIter)
+		&& fractal->setSinglePrecision(true);
+	if (singlePrecision)
+		cout << "Rendering in single precision.\n";
+	// the formula's kernel is picked once for the whole render
+	const orbitKernel kernel = fractal->kernel();
 
-	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
-	for (int pass = 0; pass < maxPasses; pass++)
+	if (continueRender)
+	{
+		if (!gbuf.open(gBufferFile, true))
+		{
+			cout << "Could not open G-buffer " << gBufferFile << "\n";
+			return 1;
+		}
+		const int oldMaxIter = gbuf.maxIter();
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+		const long long continued = continueCappedSamples(gbuf, gBufferFile, *fractal, fractal->continuation(), maxIter);
+		std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+		if (continued < 0)
+		{
+			cout << "Could not continue the capped samples of " << gBufferFile << "\n";
+			return 1;
+		}
+		std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+		cout << "Continued " << continued << " samples from maxIter " << oldMaxIter << " to " << gbuf.maxIter()
+			<< " in " << time_span.count() << " seconds.\n";
+		std::vector<int> sampleCount;
+		recolor(gbuf, [](const gSample &s) { return sampleColor(s.iter(), s.bailedOut()); }, image, sampleCount);
+		writeImage(image, sampleCount, gbuf.width(), gbuf.height());
+		delete fractal;
+		return 0;
+	}
+
+	// Mariani-Silver subdivision over the pixel centers first: previewOnly writes
+	// its one sample per pixel image and stops, otherwise the AA passes skip the
+	// pixels it found deep inside the set (their samples are all black anyway)
+	const bool subdivision = fractal->simplyConnectedInterior();
+	const bool previewOnly = false;
+	interiorMap interior((subdivision || previewOnly) ? imgWidth : 0, (subdivision || previewOnly) ? imgHeight : 0);
+	if (subdivision || previewOnly)
+	{
+		std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+		interior.trace(*fractal, kernel, [&](const double x, const double y)
+		{
+			return (deepZoom) ? transform.offset(x, y) : transform.coordinate(x, y);
+		}, maxIter);
+		std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
+		cout << "Subdivision iterated " << interior.iteratedCount() << " and filled " << interior.filledCount()
+			<< " of " << imgWidth*imgHeight << " pixels in " << time_span.count() << " seconds.\n";
+	}
+	if (previewOnly)
 	{
-		cout << "Pass " << pass << "... ";
-     	        #pragma omp parallel for schedule(dynamic,1)
 		for (int ii = 0; ii < imgHeight; ii++)
 		{
-                  //cout << "Hello from thread ???"; //<< omp_get_thread_num() << "\n";
 			for (int jj = 0; jj < imgWidth; jj++)
 			{
-				const int pixelIndex = ii*imgWidth+jj;
-				// abstractBaseFractal *fractal;
-				// JuliaSet jul; // initiate fractal formula with seed, bailout, maxIter
-				// fractal = &jul;
-				abstractBaseFractal* fractal; //getFractal(fractalName); //, params);
-				JuliaSet fr;
-				fractal = &fr;
-				const double hashValue = uintToDouble(hash(pixelIndex));
-				const double xOffset = std::min(maxPasses - 1, 1) * triDist(wrap1d((double)pass*invMaxPasses, hashValue)); // Hammersley
-				const double yOffset = std::min(maxPasses - 1, 1) * triDist(wrap1d(halton<2>(pass), hashValue));
-				const double xShifted = jj + xOffset;
-				const double yShifted = ii + yOffset;
-				const complex z0 = getComplexCoordinate(xShifted, yShifted, center, 
-					magn, rotation, skew, span, imgWidth, imgHeight);
-				complex z;
-				int iter = 0;
-				bool bailedOut = false;
-				z = fractal->start(z, z0);
-				while (!bailedOut && iter < fr.maxIter)
+				const orbitResult &result = interior.at(jj, ii);
+				const color pixelColor = sampleColor(result.iter, result.bailedOut);
+				const int pixelIndex = ii*imgWidth + jj;
+				image[3*pixelIndex    ] = pixelColor.r;
+				image[3*pixelIndex + 1] = pixelColor.g;
+				image[3*pixelIndex + 2] = pixelColor.b;
+			}
+		}
+		writeImage(image, std::vector<int>(imgWidth*imgHeight, 1), imgWidth, imgHeight);
+		delete fractal;
+		return 0;
+	}
+
+	// adaptive sampling: stop sampling converged pixels and spend up to
+	// adaptive.maxSamples on noisy ones instead of maxPasses everywhere
+	const bool adaptiveSampling = false;
+	adaptiveSettings adaptive;
+	adaptive.maxSamples = 4 * maxPasses;
+	varianceBuffer stats(adaptiveSampling ? imgWidth*imgHeight : 0, adaptive);
+	const int samplesCap = (adaptiveSampling) ? adaptive.maxSamples : maxPasses;
+	cappedSampleWriter cappedSamples;
+	if (writeGBuffer && (!gbuf.create(gBufferFile, imgWidth, imgHeight, samplesCap, maxIter)
+		|| !cappedSamples.open(cappedSamplesPath(gBufferFile))))
+	{
+		cout << "Could not create G-buffer " << gBufferFile << "\n";
+		return 1;
+	}
+
+	// symmetric sets viewed symmetrically only render the pixels before their
+	// mirror partner, the others are copied after rendering (not with a
+	// G-buffer, which keeps every sample of every pixel)
+	const bool useSymmetry = true;
+	const pixelMirror mirror = (useSymmetry && !writeGBuffer)
+		? pixelMirror(fractal->symmetry(), [&](const double x, const double y)
+			{
+				return transform.coordinate(x, y);
+			}, imgWidth, imgHeight)
+		: pixelMirror();
+	if (mirror.active())
+		cout << "Symmetric view, rendering half of the pixels.\n";
+
+	// tiles are (region x pass range) units, a worker keeps a tile's accumulation
+	// in cache for passesPerTile passes before writing it back to the image
+	const int tileSize = 32;
+	const int passesPerTile = 64;
+	tileScheduler scheduler(image, imgWidth, imgHeight, samplesCap, tileSize, passesPerTile);
+	const float footprintScale = 1.f / std::sqrt((float)samplesCap);
+
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+	scheduler.run([&](const tile &t, std::vector<float> &accumulation)
+	{
+		bool needsMorePasses = !adaptiveSampling;
+		// all samples of one pass over the tile go through the kernel as one batch
+		std::vector<complex> z0(t.pixels());
+		std::vector<int> batchPixels(t.pixels());
+		std::vector<double> xBatch(t.pixels()), yBatch(t.pixels());
+		std::vector<orbitResult> results(t.pixels());
+		std::vector<cappedSample> capped;
+		std::vector<color> colors(t.pixels());
+		std::vector<float> positions(t.pixels()), footprints(t.pixels());
+		std::vector<int> batchSlot(t.pixels());
+		const auto addSample = [&](const int pixelIndex, const int pass, const complex &z0, const orbitResult &result,
+			const color &pixelColor)
+		{
+			const int localIndex = (pixelIndex / imgWidth - t.y0)*t.width() + pixelIndex % imgWidth - t.x0;
+			if (writeGBuffer)
+			{
+				gbuf.at(pixelIndex, pass) = gSample::fromResult(result);
+				if (!result.bailedOut && !result.inside)
+					capped.push_back({pixelIndex, pass, z0, result.z});
+			}
+			accumulation[3*localIndex    ] += pixelColor.r;
+			accumulation[3*localIndex + 1] += pixelColor.g;
+			accumulation[3*localIndex + 2] += pixelColor.b;
+			if (adaptiveSampling)
+			{
+				stats.add(pixelIndex, luminance(pixelColor));
+				needsMorePasses = needsMorePasses || !stats.converged(pixelIndex);
+			}
+		};
+		// samples of interior pixels are not iterated, they count as inside
+		const orbitResult interiorResult = {complex(0), maxIter, false, true};
+		for (int pass = t.passBegin; pass < t.passEnd; pass++)
+		{
+			int batchSize = 0;
+			std::fill(batchSlot.begin(), batchSlot.end(), -1);
+			for (int ii = t.y0; ii < t.y1; ii++)
+			{
+				for (int jj = t.x0; jj < t.x1; jj++)
 				{
-					z = fractal->iterate(z, z0);
-					//cout << z << " ";
-					iter++;
-					bailedOut = fractal->bailoutCheck(z, iter);
+					const int pixelIndex = ii*imgWidth+jj;
+					if (mirror.isCopy(jj, ii) || (adaptiveSampling && stats.converged(pixelIndex)))
+						continue;
+					if (subdivision && interior.skip(jj, ii))
+					{
+						addSample(pixelIndex, pass, complex(0), interiorResult, color(0));
+						continue;
+					}
+					const double hashValue = uintToDouble(hash(pixelIndex));
+					// the number of samples is not known in advance in adaptive mode,
+					// use the progressive Halton(3) sequence instead of Hammersley then
+					const double xSample = (adaptiveSampling) ? halton<3>(pass) : (double)pass*invMaxPasses;
+					const double xOffset = std::min(maxPasses - 1, 1) * triDist(wrap1d(xSample, hashValue)); // Hammersley
+					const double yOffset = std::min(maxPasses - 1, 1) * triDist(wrap1d(halton<2>(pass), hashValue));
+					xBatch[batchSize] = jj + xOffset;
+					yBatch[batchSize] = ii + yOffset;
+					batchPixels[batchSize] = pixelIndex;
+					batchSlot[(ii - t.y0)*t.width() + jj - t.x0] = batchSize;
+					batchSize++;
 				}
-				//float grayVal = (iter < fr.maxIter) ? 1.f : 0.f; //0.5f*std::cos(0.1f*iter) : 0.f;
-				//color pixelColor = (bailedOut) ? sRGBtoLinear(standard_muted.get_color(0.1*sqrt((float)iter))) : color(0);
-				color pixelColor = (bailedOut) ? volcano_under_a_glacier.get_color(0.1*sqrt((float)iter)) : color(0);
-				//color pixelColor = (bailedOut) ? standard_muted.get_color(0.1*sqrt((float)iter)) : color(0);
-				//color pixelColor = (bailedOut) ? standard_muted.get_color(0.05*(float)iter) : color(0);
-				//color pixelColor = (bailedOut) ? ((iter/5)%2 == 1) ? color(1) : color(0) : color(0);
-				//cout << iter << "," << (float)iter/100. << ":" << pixelColor << "\n";
-				image[3*pixelIndex    ] += pixelColor.r; //grayVal;
-				image[3*pixelIndex + 1] += pixelColor.g; //grayVal;
-				image[3*pixelIndex + 2] += pixelColor.b; //grayVal;
 			}
+			// deep zoom kernels take the offset from the center
+			if (deepZoom)
+				transform.offsets(xBatch.data(), yBatch.data(), z0.data(), batchSize);
+			else
+				transform.coordinates(xBatch.data(), yBatch.data(), z0.data(), batchSize);
+			kernel(*fractal, z0.data(), results.data(), batchSize);
+			for (int kk = 0; kk < batchSize; kk++)
+				positions[kk] = gradientPosition(results[kk].iter);
+			if (filterGradient)
+				sampleFootprints(results.data(), positions.data(), batchSlot, t.width(), t.height(), footprintScale, footprints.data());
+			sampleColors(results.data(), positions.data(), (filterGradient) ? footprints.data() : nullptr, colors.data(), batchSize);
+			for (int kk = 0; kk < batchSize; kk++)
+				addSample(batchPixels[kk], pass, z0[kk], results[kk], colors[kk]);
 		}
-		cout << "Done.\n";
-	}
+		cappedSamples.append(capped);
+		return needsMorePasses;
+	});
+	if (writeGBuffer && !cappedSamples.close())
+		cout << "Could not write the capped samples of " << gBufferFile << "\n";
+	if (const blaCounters *counters = fractal->deepZoomCounters())
+		cout << "BLA skipped " << counters->skipped << " of " << counters->iterations << " iterations.\n";
 	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
 	std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
 	std::cout << "Calculation took " << time_span.count() << " seconds.\n";
-	writeImage(image, imgWidth, imgHeight, maxPasses);
+	std::vector<int> sampleCount = (adaptiveSampling) ? stats.sampleCounts() : std::vector<int>(imgWidth*imgHeight, maxPasses);
+	mirror.fill(image, 3);
+	mirror.fill(sampleCount);
+	if (adaptiveSampling)
+	{
+		long long totalSamples = 0;
+		for (const int n : sampleCount)
+			totalSamples += n;
+		cout << "Adaptive sampling used " << (double)totalSamples / sampleCount.size() << " samples per pixel on average.\n";
+	}
+	writeImage(image, sampleCount, imgWidth, imgHeight);
+	delete fractal;
 	return 0;
 }